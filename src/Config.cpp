@@ -28,6 +28,7 @@
 #include "core/View.h"
 #include "core/Logging_p.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
@@ -74,8 +75,15 @@ public:
     double m_draggedWindowOpacity = std::numeric_limits<double>::quiet_NaN();
     bool m_transparencyOnlyOverDropIndicator = false;
     int m_mdiPopupThreshold = 250;
+    int m_separatorMoveInterval = -1;
+    int m_windowResizeInterval = -1;
+    int m_placeholderMaxAge = -1;
+    int m_maxPlaceholdersPerLayout = -1;
+    int m_placeholderCompactionInterval = -1;
+    int m_layoutFileCacheSize = 0;
     int m_startDragDistance = -1;
     bool m_dropIndicatorsInhibited = false;
+    bool m_lazyWindowResize = false;
     bool m_layoutSaverStrictMode = false;
     bool m_showTabsAtBottom = false;
 };
@@ -217,6 +225,21 @@ void Config::setSeparatorThickness(int value)
     Item::layoutSpacing = value;
 }
 
+int Config::maxRecycledSeparators() const
+{
+    return Item::maxRecycledSeparators;
+}
+
+void Config::setMaxRecycledSeparators(int value)
+{
+    if (value < 0) {
+        std::cerr << "Config::setMaxRecycledSeparators: Invalid value" << value << "\n";
+        return;
+    }
+
+    Item::maxRecycledSeparators = value;
+}
+
 void Config::setLayoutSpacing(int value)
 {
     if (!DockRegistry::self()->isEmpty(/*excludeBeingDeleted=*/true)) {
@@ -419,6 +442,76 @@ int Config::mdiPopupThreshold() const
     return d->m_mdiPopupThreshold;
 }
 
+void Config::setSeparatorMoveInterval(int ms)
+{
+    d->m_separatorMoveInterval = ms < 0 ? -1 : ms;
+}
+
+int Config::separatorMoveInterval() const
+{
+    return d->m_separatorMoveInterval;
+}
+
+void Config::setWindowResizeInterval(int ms)
+{
+    d->m_windowResizeInterval = ms < 0 ? -1 : ms;
+}
+
+int Config::windowResizeInterval() const
+{
+    return d->m_windowResizeInterval;
+}
+
+void Config::setLazyWindowResize(bool lazy)
+{
+    d->m_lazyWindowResize = lazy;
+}
+
+bool Config::lazyWindowResize() const
+{
+    return d->m_lazyWindowResize;
+}
+
+void Config::setPlaceholderMaxAge(int ms)
+{
+    d->m_placeholderMaxAge = ms < 0 ? -1 : ms;
+}
+
+int Config::placeholderMaxAge() const
+{
+    return d->m_placeholderMaxAge;
+}
+
+void Config::setMaxPlaceholdersPerLayout(int max)
+{
+    d->m_maxPlaceholdersPerLayout = max < 0 ? -1 : max;
+}
+
+int Config::maxPlaceholdersPerLayout() const
+{
+    return d->m_maxPlaceholdersPerLayout;
+}
+
+void Config::setPlaceholderCompactionInterval(int ms)
+{
+    d->m_placeholderCompactionInterval = ms < 0 ? -1 : ms;
+}
+
+int Config::placeholderCompactionInterval() const
+{
+    return d->m_placeholderCompactionInterval;
+}
+
+void Config::setLayoutFileCacheSize(int bytes)
+{
+    d->m_layoutFileCacheSize = std::max(0, bytes);
+}
+
+int Config::layoutFileCacheSize() const
+{
+    return d->m_layoutFileCacheSize;
+}
+
 void Config::setDropIndicatorsInhibited(bool inhibit) const
 {
     if (d->m_dropIndicatorsInhibited != inhibit) {
@@ -221,6 +221,9 @@ public:
      * If a DockWidget doesn't exist then a DockWidgetFactoryFunc function is
      * required, so the layout saver can ask to create the DockWidget and then
      * restore it.
+     *
+     * If the dock widget's guest is expensive to create, consider giving it one with
+     * DockWidget::setGuestViewProvider() instead, so it's only created if it's ever shown.
      */
     void setDockWidgetFactoryFunc(DockWidgetFactoryFunc);
 
@@ -272,6 +275,14 @@ public:
     /// Note: Only use this function at startup before creating any DockWidget or MainWindow.
     void setLayoutSpacing(int);
 
+    /// Returns how many unused separators each layout keeps, per orientation, to reuse instead of
+    /// creating new ones when docking. Default is 16.
+    int maxRecycledSeparators() const;
+
+    /// Setter for maxRecycledSeparators(). 0 disables recycling, separators are then deleted as
+    /// soon as they're not needed.
+    void setMaxRecycledSeparators(int);
+
     ///@brief sets the dragged window opacity
     /// 1.0 is fully opaque while 0.0 is fully transparent
     void setDraggedWindowOpacity(double opacity);
@@ -400,6 +411,62 @@ public:
     void setMDIPopupThreshold(int);
     int mdiPopupThreshold() const;
 
+    /// @brief Sets how often a separator being dragged moves, in milliseconds
+    /// By default (-1) every mouse move is applied right away, which, with high polling-rate mice
+    /// and dense layouts, can be more layouting than the UI thread can keep up with.
+    /// With 0, moves are coalesced and applied about once per frame, with a timer paced to the
+    /// refresh rate of the separator's screen. Frontends which can't tell the refresh rate assume 60Hz.
+    /// With a positive value they're applied at most once per that interval.
+    /// The last position is always applied when the mouse is released.
+    /// Has no effect with Flag_LazyResize, which only resizes on release anyway.
+    void setSeparatorMoveInterval(int ms);
+    int separatorMoveInterval() const;
+
+    /// @brief Sets how often a floating or MDI window being resized with the mouse is resized, in milliseconds
+    /// Like setSeparatorMoveInterval(), but for the window edges. By default (-1) every mouse move
+    /// resizes right away, which, for windows with many dock widgets, relayouts them all each time.
+    /// With 0, only the latest geometry is applied, about once per frame of the window's screen.
+    /// With a positive value it's applied at most once per that interval.
+    /// The last geometry is always applied when the mouse is released.
+    /// Has no effect with setLazyWindowResize(true).
+    void setWindowResizeInterval(int ms);
+    int windowResizeInterval() const;
+
+    /// @brief Sets whether resizing a floating or MDI window with the mouse only shows a rubber band
+    /// The window is only resized when the mouse is released, like Flag_LazyResize does for separators.
+    /// For floating windows this is only supported with QtWidgets, other frontends resize them as usual.
+    /// Default is false.
+    void setLazyWindowResize(bool);
+    bool lazyWindowResize() const;
+
+    /// @brief Sets after how long a closed dock widget's placeholder is removed, in milliseconds
+    /// A placeholder is the hidden layout item which remembers where a closed dock widget was,
+    /// so it can be restored there. Once removed, the dock widget opens floating instead.
+    /// By default (-1) placeholders are kept for as long as their layout exists.
+    /// Only applied by DockRegistry::compactPlaceholders(), see setPlaceholderCompactionInterval().
+    void setPlaceholderMaxAge(int ms);
+    int placeholderMaxAge() const;
+
+    /// @brief Sets how many placeholders each layout keeps, the oldest ones being removed first
+    /// By default (-1) there's no limit. See setPlaceholderMaxAge()
+    void setMaxPlaceholdersPerLayout(int);
+    int maxPlaceholdersPerLayout() const;
+
+    /// @brief Sets how long after a dock widget is closed placeholders are compacted, in milliseconds
+    /// If the user is dragging or a layout is being restored by then, it's tried again later.
+    /// By default (-1) placeholders are only compacted by calling DockRegistry::compactPlaceholders().
+    void setPlaceholderCompactionInterval(int ms);
+    int placeholderCompactionInterval() const;
+
+    /// @brief Sets how many bytes of layout files LayoutSaver::restoreFromFile() keeps parsed in memory
+    /// Restoring a file that's cached, and didn't change since, skips parsing and validating it,
+    /// which makes switching between a few saved perspectives cheaper. See LayoutSaver::preloadFile().
+    /// The size is the one of the files, the least recently used ones are dropped first.
+    /// Note that the parsed documents kept in memory are several times larger than the files.
+    /// By default (0) nothing is cached.
+    void setLayoutFileCacheSize(int bytes);
+    int layoutFileCacheSize() const;
+
     /// @brief Sets how many pixels the mouse needs to travel before a drag is actually started
     /// Calling this is usually unneeded and just provided as a means to override
     /// Platform::startDragDistance() , which already has a reasonable default 4 pixels
@@ -238,6 +238,33 @@ private:
     DefaultSizeMode sizeMode = DefaultSizeMode::Fair;
 };
 
+/// @brief What compacting placeholders reclaimed
+/// @sa DockRegistry::compactPlaceholders(), Core::Layout::compactPlaceholders()
+struct PlaceholderCompactionResult
+{
+    /// Hidden layout items which were removed. Closed dock widgets won't be restored there anymore.
+    int removedPlaceholders = 0;
+
+    /// How many references to those items dock widgets were holding
+    int removedReferences = 0;
+
+    /// Containers which were removed because they became empty or redundant
+    int removedContainers = 0;
+
+    bool isEmpty() const
+    {
+        return removedPlaceholders == 0 && removedReferences == 0 && removedContainers == 0;
+    }
+
+    PlaceholderCompactionResult &operator+=(const PlaceholderCompactionResult &other)
+    {
+        removedPlaceholders += other.removedPlaceholders;
+        removedReferences += other.removedReferences;
+        removedContainers += other.removedContainers;
+        return *this;
+    }
+};
+
 enum RestoreOption {
     RestoreOption_None = 0,
     RestoreOption_RelativeToMainWindow =
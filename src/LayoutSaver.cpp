@@ -22,12 +22,14 @@
 #include "core/LayoutSaver_p.h"
 #include "core/Logging_p.h"
 #include "core/Position_p.h"
+#include "core/Profiler_p.h"
 #include "core/Utils_p.h"
 #include "core/View_p.h"
 
 #include "core/DockRegistry.h"
 #include "core/Platform.h"
 #include "core/Layout.h"
+#include "core/DropArea.h"
 #include "core/Group.h"
 #include "core/FloatingWindow.h"
 #include "core/DockWidget.h"
@@ -35,12 +37,25 @@
 #include "core/MainWindow.h"
 #include "core/nlohmann_helpers_p.h"
 #include "core/layouting/Item_p.h"
+#include "core/layouting/LayoutingHost_p.h"
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
 
+#ifdef KDDW_FRONTEND_QT
+#include <QDateTime>
+#include <QFileInfo>
+#endif
+
 /**
  * Some implementation details:
  *
@@ -68,6 +83,10 @@ std::map<QString, LayoutSaver::DockWidget::Ptr> LayoutSaver::DockWidget::s_dockW
 LayoutSaver::Layout *LayoutSaver::Layout::s_currentLayoutBeingRestored = nullptr;
 std::unordered_map<QString, std::shared_ptr<KDDockWidgets::Positions>> LayoutSaver::Private::s_unrestoredPositions;
 std::unordered_map<QString, CloseReason> LayoutSaver::Private::s_unrestoredProperties;
+LayoutSaver::Private::FileCache LayoutSaver::Private::s_fileCache;
+
+/// CBOR's self-describe tag (55799). Binary layouts start with it, so they can be told apart from JSON.
+static const char s_cborSelfDescribeTag[] = { char(0xd9), char(0xd9), char(0xf7) };
 
 static InternalRestoreOptions internalRestoreOptions(RestoreOptions options)
 {
@@ -403,71 +422,283 @@ bool LayoutSaver::saveToFile(const QString &jsonFilename)
 
 bool LayoutSaver::restoreFromFile(const QString &jsonFilename)
 {
-    bool ok = false;
-    const QByteArray data = Platform::instance()->readFile(jsonFilename, /*by-ref*/ ok);
+    // A cached file which didn't change isn't even read
+    const bool isCached = Private::isCachedAndUnchanged(jsonFilename);
 
-    if (!ok)
+    QByteArray data;
+    if (!isCached) {
+        bool ok = false;
+        data = Platform::instance()->readFile(jsonFilename, /*by-ref*/ ok);
+        if (!ok)
+            return false;
+    }
+
+    // So restoreLayout() goes through the file cache
+    d->m_fileBeingRestored = jsonFilename;
+    d->m_fileBeingRestoredIsCached = isCached;
+    const bool result = restoreLayout(data);
+    d->m_fileBeingRestored.clear();
+    d->m_fileBeingRestoredIsCached = false;
+
+    return result;
+}
+
+bool LayoutSaver::preloadFile(const QString &jsonFilename)
+{
+    if (Config::self().layoutFileCacheSize() <= 0) {
+        KDDW_ERROR("LayoutSaver::preloadFile: The cache is disabled, see Config::setLayoutFileCacheSize()");
         return false;
+    }
 
-    return restoreLayout(data);
+    if (LayoutSaver::Layout::s_currentLayoutBeingRestored) {
+        KDDW_ERROR("LayoutSaver::preloadFile: Can't be called while restoring or saving");
+        return false;
+    }
+
+    // The parsed DockWidget entries are shared by name, don't mix them with the next restore's
+    LayoutSaver::DockWidget::s_dockWidgets.clear();
+    bool result = false;
+    {
+        // Only reads the file if it's not cached yet, or changed
+        LayoutSaver::Layout layout;
+        result = Private::loadCachedLayout(jsonFilename, {}, layout);
+    }
+    LayoutSaver::DockWidget::s_dockWidgets.clear();
+
+    return result && Private::s_fileCache.entries.count(jsonFilename) > 0;
+}
+
+void LayoutSaver::clearFileCache()
+{
+    Private::s_fileCache.clear();
 }
 
 QByteArray LayoutSaver::serializeLayout() const
 {
-    if (!d->m_dockRegistry->isSane()) {
-        KDDW_ERROR("Refusing to serialize this layout. Check previous warnings.");
+    LayoutSaver::Layout layout;
+    if (!d->serializeLayout(layout))
         return {};
-    }
 
+    return layout.toJson();
+}
+
+QByteArray LayoutSaver::serializeLayoutBinary() const
+{
     LayoutSaver::Layout layout;
+    if (!d->serializeLayout(layout))
+        return {};
+
+    return layout.toBinary();
+}
+
+QByteArray LayoutSaver::serializeLayoutIncremental()
+{
+    nlohmann::json json;
+    if (!d->serializeLayoutSnapshot(json))
+        return {};
+
+    QByteArray result = QByteArray::fromStdString(json.dump(4));
+    d->m_snapshotCache.lastSnapshot = std::move(json);
+    return result;
+}
+
+QByteArray LayoutSaver::serializeLayoutPatch()
+{
+    nlohmann::json json;
+    if (!d->serializeLayoutSnapshot(json))
+        return {};
+
+    const nlohmann::json patch = nlohmann::json::diff(d->m_snapshotCache.lastSnapshot, json);
+    d->m_snapshotCache.lastSnapshot = std::move(json);
+    return QByteArray::fromStdString(patch.dump());
+}
+
+QByteArray LayoutSaver::applyLayoutPatch(const QByteArray &serialized, const QByteArray &patch)
+{
+    nlohmann::json json = serialized.isEmpty()
+        ? nlohmann::json::object()
+        : nlohmann::json::parse(serialized, nullptr, /*allow_exceptions=*/false);
+    const nlohmann::json patchJson = nlohmann::json::parse(patch, nullptr, /*allow_exceptions=*/false);
+    if (json.is_discarded() || patchJson.is_discarded()) {
+        KDDW_ERROR("LayoutSaver::applyLayoutPatch: Failed to parse input");
+        return {};
+    }
+
+    try {
+        json.patch_inplace(patchJson);
+    } catch (const std::exception &e) {
+        KDDW_ERROR("LayoutSaver::applyLayoutPatch: Caught exception: {}", e.what());
+        return {};
+    }
+
+    return QByteArray::fromStdString(json.dump(4));
+}
+
+bool LayoutSaver::Private::serializeLayout(LayoutSaver::Layout &layout) const
+{
+    if (!m_dockRegistry->isSane()) {
+        KDDW_ERROR("Refusing to serialize this layout. Check previous warnings.");
+        return false;
+    }
 
     // Just a simplification. One less type of windows to handle.
-    d->m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
+    m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
 
-    const auto mainWindows = d->m_dockRegistry->mainwindows();
+    const auto mainWindows = m_dockRegistry->mainwindows();
     layout.mainWindows.reserve(mainWindows.size());
     for (auto mainWindow : mainWindows) {
-        if (d->matchesAffinity(mainWindow->affinities()))
+        if (matchesAffinity(mainWindow->affinities()))
             layout.mainWindows.push_back(mainWindow->serialize());
     }
 
     const Vector<Core::FloatingWindow *> floatingWindows =
-        d->m_dockRegistry->floatingWindows(/*includeBeingDeleted=*/false, /*honourSkipped=*/true);
+        m_dockRegistry->floatingWindows(/*includeBeingDeleted=*/false, /*honourSkipped=*/true);
     layout.floatingWindows.reserve(floatingWindows.size());
     for (Core::FloatingWindow *floatingWindow : floatingWindows) {
-        if (d->matchesAffinity(floatingWindow->affinities()))
+        if (matchesAffinity(floatingWindow->affinities()))
             layout.floatingWindows.push_back(floatingWindow->serialize());
     }
 
     // Closed dock widgets also have interesting things to save, like geometry and placeholder info
-    const Core::DockWidget::List closedDockWidgets = d->m_dockRegistry->closedDockwidgets(/*honourSkipped=*/true);
+    const Core::DockWidget::List closedDockWidgets = m_dockRegistry->closedDockwidgets(/*honourSkipped=*/true);
     layout.closedDockWidgets.reserve(closedDockWidgets.size());
     for (Core::DockWidget *dockWidget : closedDockWidgets) {
-        if (d->matchesAffinity(dockWidget->affinities()))
+        if (matchesAffinity(dockWidget->affinities()))
             layout.closedDockWidgets.push_back(dockWidget->d->serialize());
     }
 
     // Save the placeholder info. We do it last, as we also restore it last, since we need all items
     // to be created before restoring the placeholders
 
-    const Core::DockWidget::List dockWidgets = d->m_dockRegistry->dockwidgets();
+    const Core::DockWidget::List dockWidgets = m_dockRegistry->dockwidgets();
     layout.allDockWidgets.reserve(dockWidgets.size());
     for (Core::DockWidget *dockWidget : dockWidgets) {
-        if (!dockWidget->skipsRestore() && d->matchesAffinity(dockWidget->affinities())) {
+        if (!dockWidget->skipsRestore() && matchesAffinity(dockWidget->affinities())) {
             auto dw = dockWidget->d->serialize();
             dw->lastPosition = dockWidget->d->lastPosition()->serialize();
             layout.allDockWidgets.push_back(dw);
         }
     }
 
-    return layout.toJson();
+    return true;
+}
+
+/// Writes the top-level document of a serialized layout.
+/// Shared by Layout's to_json() and by LayoutSaver::Private::serializeLayoutSnapshot(), which
+/// passes JSON it has cached instead of the Layout's lists.
+static void layoutDocumentToJson(nlohmann::json &j, const LayoutSaver::Layout &layout,
+                                 nlohmann::json mainWindows, nlohmann::json floatingWindows,
+                                 const Vector<QString> &closedDockWidgetNames,
+                                 nlohmann::json allDockWidgets)
+{
+    j["serializationVersion"] = layout.serializationVersion;
+    j["mainWindows"] = std::move(mainWindows);
+    j["floatingWindows"] = std::move(floatingWindows);
+    j["closedDockWidgets"] = closedDockWidgetNames;
+    j["allDockWidgets"] = std::move(allDockWidgets);
+    j["screenInfo"] = layout.screenInfo;
+}
+
+bool LayoutSaver::Private::serializeLayoutSnapshot(nlohmann::json &json)
+{
+    if (!m_dockRegistry->isSane()) {
+        KDDW_ERROR("Refusing to serialize this layout. Check previous warnings.");
+        return false;
+    }
+
+    m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
+
+    // Produces the same document as serializeLayout() + Layout::toJson(), but the layouts and
+    // placeholders, which are the expensive parts, are only serialized again if they changed.
+    // Everything else is cheap and always saved.
+    // Entries which weren't used in this snapshot belong to deleted objects and are dropped.
+    decltype(m_snapshotCache.layouts) usedLayouts;
+    decltype(m_snapshotCache.placeholders) usedPlaceholders;
+
+    auto serializedLayout = [this, &usedLayouts](Core::Layout *layout) -> const nlohmann::json & {
+        const uint64_t generation = layout->asLayoutingHost()->generation();
+        SnapshotCache::LayoutEntry entry;
+        auto it = m_snapshotCache.layouts.find(layout);
+        if (it != m_snapshotCache.layouts.end() && it->second.generation == generation) {
+            entry = std::move(it->second);
+        } else {
+            entry.generation = generation;
+            entry.serialized = layout->serialize();
+        }
+
+        return (usedLayouts[layout] = std::move(entry)).serialized;
+    };
+
+    nlohmann::json mainWindowsJson = nlohmann::json::array();
+    for (auto mainWindow : m_dockRegistry->mainwindows()) {
+        if (matchesAffinity(mainWindow->affinities())) {
+            nlohmann::json mainWindowJson = mainWindow->serializeWithoutLayout();
+            mainWindowJson["multiSplitterLayout"] = serializedLayout(mainWindow->layout());
+            mainWindowsJson.push_back(std::move(mainWindowJson));
+        }
+    }
+
+    nlohmann::json floatingWindowsJson = nlohmann::json::array();
+    const Vector<Core::FloatingWindow *> floatingWindows =
+        m_dockRegistry->floatingWindows(/*includeBeingDeleted=*/false, /*honourSkipped=*/true);
+    for (Core::FloatingWindow *floatingWindow : floatingWindows) {
+        if (matchesAffinity(floatingWindow->affinities())) {
+            nlohmann::json floatingWindowJson = floatingWindow->serializeWithoutLayout();
+            floatingWindowJson["multiSplitterLayout"] = serializedLayout(floatingWindow->dropArea());
+            floatingWindowsJson.push_back(std::move(floatingWindowJson));
+        }
+    }
+
+    Vector<QString> closedDockWidgetNames;
+    for (Core::DockWidget *dockWidget : m_dockRegistry->closedDockwidgets(/*honourSkipped=*/true)) {
+        if (matchesAffinity(dockWidget->affinities()))
+            closedDockWidgetNames.push_back(dockWidget->uniqueName());
+    }
+
+    // What the placeholder keys index into, same as what Positions::serializePlaceholders() uses
+    const Vector<Core::FloatingWindow *> allFloatingWindows = m_dockRegistry->floatingWindows();
+
+    nlohmann::json allDockWidgetsJson = nlohmann::json::array();
+    for (Core::DockWidget *dockWidget : m_dockRegistry->dockwidgets()) {
+        if (dockWidget->skipsRestore() || !matchesAffinity(dockWidget->affinities()))
+            continue;
+
+        const Positions *positions = dockWidget->d->lastPosition().get();
+        auto dw = dockWidget->d->serialize();
+        dw->lastPosition = positions->serializeWithoutPlaceholders();
+
+        SnapshotCache::PlaceholdersEntry entry;
+        std::vector<uint64_t> key = positions->placeholdersSerializationKey(allFloatingWindows);
+        auto it = m_snapshotCache.placeholders.find(positions);
+        if (it != m_snapshotCache.placeholders.end() && it->second.key == key) {
+            entry = std::move(it->second);
+        } else {
+            entry.key = std::move(key);
+            entry.placeholders = positions->serializePlaceholders();
+        }
+
+        dw->lastPosition.placeholders = entry.placeholders;
+        usedPlaceholders[positions] = std::move(entry);
+        allDockWidgetsJson.push_back(*dw);
+    }
+
+    layoutDocumentToJson(json, LayoutSaver::Layout(), std::move(mainWindowsJson),
+                         std::move(floatingWindowsJson), closedDockWidgetNames,
+                         std::move(allDockWidgetsJson));
+
+    m_snapshotCache.layouts = std::move(usedLayouts);
+    m_snapshotCache.placeholders = std::move(usedPlaceholders);
+
+    return true;
 }
 
 bool LayoutSaver::restoreLayout(const QByteArray &data)
 {
+    KDDW_PROFILE_SCOPE("LayoutSaver::restoreLayout");
+    KDDW_PROFILE_PHASES(phases);
     LayoutSaver::DockWidget::s_dockWidgets.clear();
     d->clearRestoredProperty();
-    if (data.isEmpty())
+    if (data.isEmpty() && !d->m_fileBeingRestoredIsCached)
         return true;
 
     struct GroupCleanup
@@ -490,14 +721,9 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
 
     GroupCleanup cleanup(this);
     LayoutSaver::Layout layout;
-    if (!layout.fromJson(data)) {
-        KDDW_ERROR("Failed to parse json data");
+    KDDW_PROFILE_PHASE(phases, "LayoutSaver::restoreLayout: parse");
+    if (!d->loadLayout(data, layout))
         return false;
-    }
-
-    if (!layout.isValid()) {
-        return false;
-    }
 
     layout.scaleSizes(d->m_restoreOptions);
 
@@ -509,11 +735,13 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
     // Hide all dockwidgets and unparent them from any layout before starting restore
     // We only close the stuff that the loaded JSON knows about. Unknown widgets might be newer.
 
+    KDDW_PROFILE_PHASE(phases, "LayoutSaver::restoreLayout: clear");
     d->m_dockRegistry->clear(d->m_dockRegistry->dockWidgets(layout.dockWidgetsToClose()),
                              d->m_dockRegistry->mainWindows(layout.mainWindowNames()),
                              d->m_affinityNames);
 
     // 1. Restore main windows
+    KDDW_PROFILE_PHASE(phases, "LayoutSaver::restoreLayout: main windows");
     for (const LayoutSaver::MainWindow &mw : std::as_const(layout.mainWindows)) {
         auto mainWindow = d->m_dockRegistry->mainWindowByName(mw.uniqueName);
         if (!mainWindow) {
@@ -545,6 +773,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
     }
 
     // 2. Restore FloatingWindows
+    KDDW_PROFILE_PHASE(phases, "LayoutSaver::restoreLayout: floating windows");
     for (LayoutSaver::FloatingWindow &fw : layout.floatingWindows) {
         if (!d->matchesAffinity(fw.affinities) || fw.skipsRestore())
             continue;
@@ -567,6 +796,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
 
     // 3. Restore closed dock widgets. They remain closed but acquire geometry and placeholder
     // properties
+    KDDW_PROFILE_PHASE(phases, "LayoutSaver::restoreLayout: closed dock widgets");
     for (const auto &dw : std::as_const(layout.closedDockWidgets)) {
         if (d->matchesAffinity(dw->affinities)) {
             Core::DockWidget::deserialize(dw);
@@ -577,6 +807,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
     LayoutSaver::Private::s_unrestoredProperties.clear();
 
     // 4. Restore the placeholder info, now that the Items have been created
+    KDDW_PROFILE_PHASE(phases, "LayoutSaver::restoreLayout: placeholders");
     for (const auto &dw : std::as_const(layout.allDockWidgets)) {
         if (!d->matchesAffinity(dw->affinities))
             continue;
@@ -593,9 +824,26 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
         }
     }
 
+    // 5. Dock widgets with a deferred guest view only get it if they're going to be visible.
+    // It wasn't done while restoring, as every tab is briefly made current
+    for (Core::DockWidget *dockWidget : d->m_dockRegistry->dockwidgets()) {
+        if (dockWidget->hasPendingGuestView() && dockWidget->isOpen() && dockWidget->isCurrentTab())
+            dockWidget->ensureGuestView();
+    }
+
     return true;
 }
 
+bool LayoutSaver::restoreLayoutBinary(const QByteArray &data)
+{
+    if (!data.isEmpty() && !LayoutSaver::Layout::isBinary(data)) {
+        KDDW_ERROR("LayoutSaver::restoreLayoutBinary: Data isn't in binary format");
+        return false;
+    }
+
+    return restoreLayout(data);
+}
+
 void LayoutSaver::setAffinityNames(const Vector<QString> &affinityNames)
 {
     d->m_affinityNames = affinityNames;
@@ -782,21 +1030,19 @@ Vector<QString> LayoutSaver::openedDockWidgetsInLayout(const QString &jsonFilena
 
 Vector<QString> LayoutSaver::openedDockWidgetsInLayout(const QByteArray &serialized)
 {
-    LayoutSaver::Layout layout;
-    if (!layout.fromJson(serialized))
+    LayoutInfo info;
+    if (!inspectLayout(serialized, info))
         return {};
 
-    Vector<QString> names;
-    names.reserve(layout.allDockWidgets.size()); // over-reserve so we have a single allocation
+    const std::unordered_set<QString> closedNames(info.closedDockWidgetNames.cbegin(),
+                                                  info.closedDockWidgetNames.cend());
 
-    for (const auto &dock : std::as_const(layout.allDockWidgets)) {
-        auto it = std::find_if(layout.closedDockWidgets.cbegin(), layout.closedDockWidgets.cend(), [&dock](auto closedDock) {
-            return dock->uniqueName == closedDock->uniqueName;
-        });
+    Vector<QString> names;
+    names.reserve(info.dockWidgetNames.size()); // over-reserve so we have a single allocation
 
-        const bool itsOpen = it == layout.closedDockWidgets.cend();
-        if (itsOpen)
-            names.push_back(dock->uniqueName);
+    for (const QString &name : std::as_const(info.dockWidgetNames)) {
+        if (closedNames.find(name) == closedNames.cend())
+            names.push_back(name);
     }
 
     return names;
@@ -815,32 +1061,216 @@ Vector<QString> LayoutSaver::sideBarDockWidgetsInLayout(const QString &jsonFilen
 
 Vector<QString> LayoutSaver::sideBarDockWidgetsInLayout(const QByteArray &serialized)
 {
-    LayoutSaver::Layout layout;
-    if (!layout.fromJson(serialized))
+    LayoutInfo info;
+    if (!inspectLayout(serialized, info))
         return {};
 
-    Vector<QString> names;
-    names.reserve(layout.allDockWidgets.size()); // over-reserve so we have a single allocation
+    return info.sideBarDockWidgetNames;
+}
+
+namespace {
+
+/// A SAX handler which picks the names out of a serialized layout, ignoring everything else.
+/// Only the containers leading to the values we want are tracked, so no DOM is built.
+class LayoutInspector
+{
+public:
+    explicit LayoutInspector(LayoutSaver::LayoutInfo &info)
+        : m_info(info)
+    {
+    }
+
+    bool null()
+    {
+        return true;
+    }
+
+    bool boolean(bool)
+    {
+        return true;
+    }
+
+    bool number_integer(nlohmann::json::number_integer_t value)
+    {
+        if (isCurrentKey(Role::Root, "serializationVersion"))
+            m_info.serializationVersion = int(value);
+        return true;
+    }
+
+    bool number_unsigned(nlohmann::json::number_unsigned_t value)
+    {
+        // CBOR reports positive integers as unsigned
+        if (isCurrentKey(Role::Root, "serializationVersion"))
+            m_info.serializationVersion = int(value);
+        return true;
+    }
+
+    bool number_float(nlohmann::json::number_float_t, const nlohmann::json::string_t &)
+    {
+        return true;
+    }
+
+    bool string(nlohmann::json::string_t &value)
+    {
+        if (m_stack.empty())
+            return true;
+
+        switch (m_stack.back().role) {
+        case Role::MainWindow:
+            if (isCurrentKey(Role::MainWindow, "uniqueName"))
+                m_info.mainWindowNames.push_back(QString::fromStdString(value));
+            break;
+        case Role::DockWidget:
+            if (isCurrentKey(Role::DockWidget, "uniqueName") && !value.empty())
+                m_info.dockWidgetNames.push_back(QString::fromStdString(value));
+            break;
+        case Role::ClosedDockWidgets:
+            m_info.closedDockWidgetNames.push_back(QString::fromStdString(value));
+            break;
+        case Role::SideBar:
+            m_info.sideBarDockWidgetNames.push_back(QString::fromStdString(value));
+            break;
+        default:
+            break;
+        }
+
+        return true;
+    }
+
+    bool binary(nlohmann::json::binary_t &)
+    {
+        return true;
+    }
 
-    for (const auto &mainWindow : std::as_const(layout.mainWindows)) {
-        for (const auto &it : mainWindow.dockWidgetsPerSideBar) {
-            for (const auto &name : it.second)
-                names.push_back(name);
+    bool start_object(std::size_t)
+    {
+        Role role = Role::Other;
+        if (m_stack.empty()) {
+            role = Role::Root;
+        } else if (m_stack.back().role == Role::MainWindows) {
+            role = Role::MainWindow;
+        } else if (m_stack.back().role == Role::AllDockWidgets) {
+            role = Role::DockWidget;
         }
+
+        m_stack.push_back({ role, {} });
+        return true;
     }
 
-    return names;
+    bool key(nlohmann::json::string_t &key)
+    {
+        m_stack.back().key = key;
+        return true;
+    }
+
+    bool end_object()
+    {
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t)
+    {
+        Role role = Role::Other;
+        if (isCurrentKey(Role::Root, "mainWindows")) {
+            role = Role::MainWindows;
+        } else if (isCurrentKey(Role::Root, "allDockWidgets")) {
+            role = Role::AllDockWidgets;
+        } else if (isCurrentKey(Role::Root, "closedDockWidgets")) {
+            role = Role::ClosedDockWidgets;
+        } else if (!m_stack.empty() && m_stack.back().role == Role::MainWindow
+                   && m_stack.back().key.rfind("sidebar-", 0) == 0) {
+            role = Role::SideBar;
+        }
+
+        m_stack.push_back({ role, {} });
+        return true;
+    }
+
+    bool end_array()
+    {
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &)
+    {
+        return false;
+    }
+
+private:
+    enum class Role {
+        Other,
+        Root,
+        MainWindows,
+        MainWindow,
+        SideBar,
+        AllDockWidgets,
+        DockWidget,
+        ClosedDockWidgets
+    };
+
+    struct Container
+    {
+        Role role;
+        std::string key; // the current key, if it's an object
+    };
+
+    bool isCurrentKey(Role role, const char *key) const
+    {
+        return !m_stack.empty() && m_stack.back().role == role && m_stack.back().key == key;
+    }
+
+    LayoutSaver::LayoutInfo &m_info;
+    std::vector<Container> m_stack;
+};
+
+}
+
+bool LayoutSaver::inspectLayout(const QString &jsonFilename, LayoutInfo &info)
+{
+    bool ok = false;
+    const QByteArray data = Platform::instance()->readFile(jsonFilename, /*by-ref*/ ok);
+
+    if (!ok)
+        return false;
+
+    return inspectLayout(data, info);
+}
+
+bool LayoutSaver::inspectLayout(const QByteArray &serialized, LayoutInfo &info)
+{
+    LayoutInfo result;
+    LayoutInspector inspector(result);
+
+    const char *begin = serialized.constData();
+    const char *end = begin + serialized.size();
+    bool ok = false;
+
+    try {
+        if (Layout::isBinary(serialized)) {
+            // Skip the self-describe tag, nlohmann's SAX entry point doesn't let us ignore tags
+            begin += sizeof(s_cborSelfDescribeTag);
+            ok = nlohmann::json::sax_parse(begin, end, &inspector, nlohmann::json::input_format_t::cbor);
+        } else {
+            ok = nlohmann::json::sax_parse(begin, end, &inspector);
+        }
+    } catch (const std::exception &e) {
+        KDDW_ERROR("LayoutSaver::inspectLayout: Caught exception: {}", e.what());
+        return false;
+    }
+
+    if (ok)
+        info = std::move(result);
+
+    return ok;
 }
 
 namespace KDDockWidgets {
 static void to_json(nlohmann::json &j, const LayoutSaver::Layout &layout)
 {
-    j["serializationVersion"] = layout.serializationVersion;
-    j["mainWindows"] = layout.mainWindows;
-    j["floatingWindows"] = layout.floatingWindows;
-    j["closedDockWidgets"] = ::dockWidgetNames(layout.closedDockWidgets);
-    j["allDockWidgets"] = layout.allDockWidgets;
-    j["screenInfo"] = layout.screenInfo;
+    ::layoutDocumentToJson(j, layout, layout.mainWindows, layout.floatingWindows,
+                           ::dockWidgetNames(layout.closedDockWidgets), layout.allDockWidgets);
 }
 
 static void from_json(const nlohmann::json &j, LayoutSaver::Layout &layout)
@@ -875,6 +1305,11 @@ bool LayoutSaver::Layout::fromJson(const QByteArray &jsonData)
         return false;
     }
 
+    return fromJsonDocument(json);
+}
+
+bool LayoutSaver::Layout::fromJsonDocument(const nlohmann::json &json)
+{
     try {
         from_json(json, *this);
     } catch (const std::exception &e) {
@@ -888,6 +1323,203 @@ bool LayoutSaver::Layout::fromJson(const QByteArray &jsonData)
     return true;
 }
 
+QByteArray LayoutSaver::Layout::toBinary() const
+{
+    nlohmann::json json = *this;
+    std::string data(std::begin(s_cborSelfDescribeTag), std::end(s_cborSelfDescribeTag));
+    nlohmann::json::to_cbor(json, data);
+    return QByteArray::fromStdString(data);
+}
+
+bool LayoutSaver::Layout::fromBinary(const QByteArray &binaryData)
+{
+    if (!isBinary(binaryData))
+        return false;
+
+    const char *begin = binaryData.constData();
+    const char *end = begin + binaryData.size();
+    nlohmann::json json = nlohmann::json::from_cbor(begin, end, /*strict=*/true, /*allow_exceptions=*/false,
+                                                    nlohmann::json::cbor_tag_handler_t::ignore);
+    if (json.is_discarded()) {
+        return false;
+    }
+
+    return fromJsonDocument(json);
+}
+
+bool LayoutSaver::Layout::fromJsonOrBinary(const QByteArray &data)
+{
+    return isBinary(data) ? fromBinary(data) : fromJson(data);
+}
+
+bool LayoutSaver::Layout::isBinary(const QByteArray &data)
+{
+    const auto tagSize = sizeof(s_cborSelfDescribeTag);
+    return size_t(data.size()) > tagSize && std::memcmp(data.constData(), s_cborSelfDescribeTag, tagSize) == 0;
+}
+
+bool LayoutSaver::Private::loadLayout(const QByteArray &data, LayoutSaver::Layout &layout) const
+{
+    if (!m_fileBeingRestored.isEmpty() && Config::self().layoutFileCacheSize() > 0)
+        return loadCachedLayout(m_fileBeingRestored, data, layout);
+
+    if (!layout.fromJsonOrBinary(data)) {
+        KDDW_ERROR("Failed to parse layout data");
+        return false;
+    }
+
+    return layout.isValid();
+}
+
+bool LayoutSaver::Private::loadCachedLayout(const QString &filename, const QByteArray &data,
+                                            LayoutSaver::Layout &layout)
+{
+    const FileCache::Stamp stamp = FileCache::stampForFile(filename);
+
+    QByteArray readData;
+    bool readOk = true;
+    auto contents = [&]() -> const QByteArray & {
+        if (data.isEmpty() && readData.isEmpty() && readOk)
+            readData = Platform::instance()->readFile(filename, /*by-ref*/ readOk);
+        return data.isEmpty() ? readData : data;
+    };
+
+    auto hashOf = [](const QByteArray &bytes) {
+        return std::hash<std::string_view>()(std::string_view(bytes.constData(), size_t(bytes.size())));
+    };
+
+    FileCache::Entry *entry = s_fileCache.find(filename, stamp);
+    if (entry && entry->needsHash()) {
+        if (entry->hash == hashOf(contents())) {
+            // Unchanged. Once it's old enough the stamp alone tells, next time.
+            entry->stamp = stamp;
+        } else {
+            entry = nullptr;
+        }
+    }
+
+    if (entry) {
+        // Already validated
+        entry->lastUsed = ++s_fileCache.useCounter;
+        return layout.fromJsonDocument(entry->document);
+    }
+
+    const QByteArray &bytes = contents();
+    if (!readOk || bytes.isEmpty())
+        return false;
+
+    if (!layout.fromJsonOrBinary(bytes)) {
+        KDDW_ERROR("Failed to parse layout data");
+        return false;
+    }
+
+    if (!layout.isValid())
+        return false;
+
+    FileCache::Entry current;
+    current.stamp = stamp;
+    current.size = bytes.size();
+    current.strictMode = Config::self().layoutSaverUsesStrictMode();
+    if (current.needsHash())
+        current.hash = hashOf(bytes);
+    current.document = layout;
+    s_fileCache.insert(filename, std::move(current));
+
+    return true;
+}
+
+bool LayoutSaver::Private::isCachedAndUnchanged(const QString &filename)
+{
+    if (Config::self().layoutFileCacheSize() <= 0 || s_fileCache.entries.empty())
+        return false;
+
+    const FileCache::Entry *entry = s_fileCache.find(filename, FileCache::stampForFile(filename));
+    return entry && !entry->needsHash();
+}
+
+LayoutSaver::Private::FileCache::Stamp LayoutSaver::Private::FileCache::stampForFile(const QString &filename)
+{
+    // Coarser than most filesystems' resolution, FAT's is 2 seconds
+    constexpr int64_t racyIntervalMs = 3000;
+
+    Stamp stamp;
+#ifdef KDDW_FRONTEND_QT
+    const QFileInfo info(filename);
+    if (!info.isFile() || filename.startsWith(QLatin1Char(':')))
+        return stamp;
+
+    stamp.modificationTime = info.lastModified().toMSecsSinceEpoch();
+    stamp.size = info.size();
+    stamp.isRecent = QDateTime::currentMSecsSinceEpoch() - stamp.modificationTime < racyIntervalMs;
+#else
+    // QString is UTF-8 here, a plain std::string would be taken as the local 8-bit encoding on Windows
+    const std::string utf8 = filename.toStdString();
+    const std::filesystem::path path(std::u8string(utf8.cbegin(), utf8.cend()));
+
+    std::error_code ec;
+    const auto modificationTime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return stamp;
+
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return stamp;
+
+    const auto age = std::filesystem::file_time_type::clock::now() - modificationTime;
+    stamp.modificationTime = int64_t(modificationTime.time_since_epoch().count());
+    stamp.size = int64_t(size);
+    stamp.isRecent = age < std::chrono::milliseconds(racyIntervalMs);
+#endif
+
+    return stamp;
+}
+
+LayoutSaver::Private::FileCache::Entry *LayoutSaver::Private::FileCache::find(const QString &filename,
+                                                                               const Stamp &stamp)
+{
+    auto it = entries.find(filename);
+    if (it == entries.end())
+        return nullptr;
+
+    const Entry &entry = it->second;
+    if (entry.stamp != stamp || entry.strictMode != Config::self().layoutSaverUsesStrictMode())
+        return nullptr;
+
+    return &it->second;
+}
+
+void LayoutSaver::Private::FileCache::insert(const QString &filename, Entry entry)
+{
+    auto it = entries.find(filename);
+    if (it != entries.end()) {
+        totalSize -= it->second.size;
+        entries.erase(it);
+    }
+
+    const int64_t maxSize = Config::self().layoutFileCacheSize();
+    if (entry.size > maxSize)
+        return;
+
+    entry.lastUsed = ++useCounter;
+    totalSize += entry.size;
+    entries.emplace(filename, std::move(entry));
+
+    while (totalSize > maxSize) {
+        auto leastRecentlyUsed = std::min_element(entries.begin(), entries.end(), [](const auto &e1, const auto &e2) {
+            return e1.second.lastUsed < e2.second.lastUsed;
+        });
+
+        totalSize -= leastRecentlyUsed->second.size;
+        entries.erase(leastRecentlyUsed);
+    }
+}
+
+void LayoutSaver::Private::FileCache::clear()
+{
+    entries.clear();
+    totalSize = 0;
+}
+
 void LayoutSaver::Layout::scaleSizes(InternalRestoreOptions options)
 {
     if (mainWindows.isEmpty())
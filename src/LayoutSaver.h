@@ -39,7 +39,8 @@ class DockWidget;
  * @brief LayoutSaver allows to save or restore layouts.
  *
  * You can save a layout to a file or to a byte array.
- * JSON is used as the serialized format.
+ * JSON is used as the serialized format. For big layouts there's also a more compact binary
+ * format, see serializeLayoutBinary().
  *
  * Example:
  *     LayoutSaver saver;
@@ -74,10 +75,26 @@ public:
     /**
      * @brief restores the layout from a JSON file
      * @param jsonFilename the filename containing a saved layout
+     * Files containing the binary format (see serializeLayoutBinary()) are also supported.
      * @return true on success
      */
     bool restoreFromFile(const QString &jsonFilename);
 
+    /**
+     * @brief parses and validates a layout file ahead of time
+     *
+     * A later restoreFromFile() of the same file won't need to parse it again, as long as the
+     * file doesn't change meanwhile. Useful for layouts the user is likely to switch to next,
+     * for example perspectives bound to shortcuts.
+     *
+     * Requires the cache to be enabled with Config::setLayoutFileCacheSize().
+     * @return true if the file is valid and is now cached
+     */
+    static bool preloadFile(const QString &jsonFilename);
+
+    /// @brief Drops the layout files cached by restoreFromFile() and preloadFile()
+    static void clearFileCache();
+
     /**
      * @brief saves the layout into a byte array
      */
@@ -93,10 +110,60 @@ public:
      *
      * @sa Config::setDockWidgetFactoryFunc()
      *
+     * The binary format from serializeLayoutBinary() is also accepted.
+     *
      * @return true on success
      */
     bool restoreLayout(const QByteArray &);
 
+    /**
+     * @brief saves the layout into a byte array, in a compact binary format
+     *
+     * Contains the same information as serializeLayout() but it's CBOR encoded instead of
+     * indented JSON, which is smaller and faster to save and restore. Useful for big layouts
+     * that are saved often.
+     */
+    QByteArray serializeLayoutBinary() const;
+
+    /**
+     * @brief restores the layout from a byte array returned by serializeLayoutBinary()
+     * Same as restoreLayout(), but fails if @p data isn't in the binary format.
+     * @return true on success
+     */
+    bool restoreLayoutBinary(const QByteArray &data);
+
+    /**
+     * @brief saves the layout into a byte array, reusing what didn't change since the last snapshot
+     *
+     * Returns the same as serializeLayout(), but parts of the layout which didn't change since
+     * the previous call to serializeLayoutIncremental() or serializeLayoutPatch() on this
+     * LayoutSaver instance aren't serialized again. Useful for frequent autosaving.
+     *
+     * The saver must be kept alive between snapshots for this to have any effect.
+     */
+    QByteArray serializeLayoutIncremental();
+
+    /**
+     * @brief returns a JSON Patch (RFC 6902) against the previous snapshot
+     *
+     * The previous snapshot is the one taken by the last call to serializeLayoutIncremental()
+     * or serializeLayoutPatch() on this instance. If there isn't one, the patch is relative to
+     * an empty JSON object.
+     * Patches can be applied with applyLayoutPatch().
+     *
+     * Returns an empty byte array on error.
+     */
+    QByteArray serializeLayoutPatch();
+
+    /**
+     * @brief applies a patch returned by serializeLayoutPatch() to a JSON layout
+     *
+     * @p serialized can be empty, in which case the patch is applied to an empty JSON object.
+     * @return The patched layout, which can be passed to restoreLayout(), or an empty byte array
+     * on error.
+     */
+    static QByteArray applyLayoutPatch(const QByteArray &serialized, const QByteArray &patch);
+
     /**
      * @brief returns a list of dock widgets which were restored since the last
      * @ref restoreLayout() or @ref restoreFromFile()
@@ -129,6 +196,31 @@ public:
     static Vector<QString> sideBarDockWidgetsInLayout(const QString &jsonFilename);
     static Vector<QString> sideBarDockWidgetsInLayout(const QByteArray &serialized);
 
+    /// @brief The names found in a serialized layout, see inspectLayout()
+    struct LayoutInfo
+    {
+        int serializationVersion = 0;
+        Vector<QString> mainWindowNames;
+        /// All dock widgets in the layout, opened and closed
+        Vector<QString> dockWidgetNames;
+        Vector<QString> closedDockWidgetNames;
+        /// Dock widgets which are in a main window's side bar
+        Vector<QString> sideBarDockWidgetNames;
+    };
+
+    /**
+     * @brief Extracts the names in a layout, without deserializing it
+     *
+     * Much cheaper than restoring or than openedDockWidgetsInLayout(), as the data is
+     * streamed instead of being turned into the full list of windows, groups and positions.
+     * Useful for listing many saved layouts. Accepts both JSON and the binary format.
+     *
+     * This operation does not have side-effects.
+     * @return false if the data couldn't be parsed, in which case @p info is left untouched
+     */
+    static bool inspectLayout(const QByteArray &serialized, LayoutInfo &info);
+    static bool inspectLayout(const QString &jsonFilename, LayoutInfo &info);
+
     /// @internal Returns the private-impl. Not intended for public use.
     class Private;
     Private *dptr() const;
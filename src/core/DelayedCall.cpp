@@ -12,7 +12,12 @@
 #include "DelayedCall_p.h"
 #include "DockWidget_p.h"
 #include "Controller.h"
+#include "Separator.h"
 #include "DragController_p.h"
+#include "DockRegistry.h"
+#include "DockRegistry_p.h"
+#include "LayoutSaver_p.h"
+#include "WidgetResizeHandler_p.h"
 #include "core/Utils_p.h"
 
 using namespace KDDockWidgets::Core;
@@ -56,3 +61,49 @@ void DelayedEmitFocusChanged::call()
         m_dockWidget->d->isFocusedChanged.emit(m_focused);
     }
 }
+
+
+DelayedSeparatorMove::DelayedSeparatorMove(Separator *separator)
+    : m_separator(separator)
+{
+}
+
+DelayedSeparatorMove::~DelayedSeparatorMove() = default;
+
+void DelayedSeparatorMove::call()
+{
+    if (m_separator)
+        m_separator->applyPendingMove();
+}
+
+DelayedWindowResize::DelayedWindowResize(WidgetResizeHandler *handler)
+    : m_handler(handler)
+{
+}
+
+DelayedWindowResize::~DelayedWindowResize() = default;
+
+void DelayedWindowResize::call()
+{
+    if (m_handler)
+        m_handler->applyPendingResize();
+}
+
+DelayedPlaceholderCompaction::~DelayedPlaceholderCompaction() = default;
+
+void DelayedPlaceholderCompaction::call()
+{
+    if (!DockRegistry::isInitialized())
+        return;
+
+    DockRegistry *registry = DockRegistry::self();
+    registry->dptr()->m_placeholderCompactionScheduled = false;
+
+    if (LayoutSaver::restoreInProgress() || !DragController::instance()->isIdle()) {
+        // Not idle yet, try again later
+        registry->schedulePlaceholderCompaction();
+        return;
+    }
+
+    registry->compactPlaceholders();
+}
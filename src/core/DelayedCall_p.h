@@ -14,10 +14,15 @@
 #include "KDDockWidgets.h"
 #include "ObjectGuard_p.h"
 
+namespace KDDockWidgets {
+class WidgetResizeHandler;
+}
+
 namespace KDDockWidgets::Core {
 
 class DockWidget;
 class Controller;
+class Separator;
 
 class DelayedCall
 {
@@ -56,4 +61,45 @@ private:
     const bool m_focused;
 };
 
+/// Applies the coalesced mouse moves of a separator, see Config::setSeparatorMoveInterval()
+class DelayedSeparatorMove : public DelayedCall
+{
+public:
+    explicit DelayedSeparatorMove(Separator *);
+    ~DelayedSeparatorMove() override;
+
+    void call() override;
+
+    KDDW_DELETE_COPY_CTOR(DelayedSeparatorMove)
+private:
+    ObjectGuard<Separator> m_separator;
+};
+
+/// Applies the coalesced resize of a floating or MDI window, see Config::setWindowResizeInterval()
+class DelayedWindowResize : public DelayedCall
+{
+public:
+    explicit DelayedWindowResize(WidgetResizeHandler *);
+    ~DelayedWindowResize() override;
+
+    void call() override;
+
+    KDDW_DELETE_COPY_CTOR(DelayedWindowResize)
+private:
+    ObjectGuard<WidgetResizeHandler> m_handler;
+};
+
+/// Compacts placeholders once the user isn't dragging or restoring,
+/// see DockRegistry::schedulePlaceholderCompaction()
+class DelayedPlaceholderCompaction : public DelayedCall
+{
+public:
+    DelayedPlaceholderCompaction() = default;
+    ~DelayedPlaceholderCompaction() override;
+
+    void call() override;
+
+    KDDW_DELETE_COPY_CTOR(DelayedPlaceholderCompaction)
+};
+
 }
@@ -29,12 +29,18 @@
 #include "core/MainWindow.h"
 #include "core/DockWidget.h"
 #include "core/DropArea.h"
+#include "core/FocusScope.h"
+#include "core/Group.h"
+#include "core/Layout.h"
+#include "core/MDILayout.h"
 #include "core/Platform.h"
 #include "core/Window_p.h"
 
 #include "kdbindings/signal.h"
 
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 using namespace KDDockWidgets;
@@ -58,6 +64,36 @@ private:
 
 }
 
+namespace {
+
+/// Removes @p obj from a uniqueName index
+/// If another object with the same (duplicate) name is registered then it gets indexed instead.
+/// @p list is expected to still contain @p obj
+template<typename T>
+void removeFromNameIndex(std::unordered_map<QString, T *> &index, const Vector<T *> &list,
+                         T *obj, const QString &name)
+{
+    auto it = index.find(name);
+    if (it == index.end() || it->second != obj)
+        return;
+
+    index.erase(it);
+
+    // Without duplicate names the index has one entry per each of the other objects.
+    // Only walk the list when that's not the case.
+    if (index.size() + 1 >= size_t(list.size()))
+        return;
+
+    for (T *other : list) {
+        if (other != obj && other->uniqueName() == name) {
+            index.emplace(name, other);
+            return;
+        }
+    }
+}
+
+}
+
 DockRegistry::DockRegistry(Core::Object *parent)
     : Core::Object(parent)
     , d(new Private())
@@ -88,27 +124,79 @@ void DockRegistry::maybeDelete()
 
 void DockRegistry::onFocusedViewChanged(std::shared_ptr<View> view)
 {
-    auto p = view;
-    while (p && !p->isNull()) {
-        if (auto group = p->asGroupController()) {
-            // Special case: The focused widget is inside the group but not inside the dockwidget.
-            // For example, it's a line edit in the QTabBar. We still need to send the signal for
-            // the current dw in the tab group
-            if (auto dw = group->currentDockWidget()) {
-                setFocusedDockWidget(dw);
+    // Resolves the focused dock widget and the focused scopes in a single walk up the parents,
+    // as each step allocates a new wrapper
+    Core::DockWidget *focusedDockWidget = nullptr;
+    bool foundDockWidget = false;
+    Vector<Core::FocusScope *> focusedScopes;
+
+    for (auto p = view; p && !p->isNull(); p = p->parentView()) {
+        if (!foundDockWidget) {
+            if (auto group = p->asGroupController()) {
+                // Special case: The focused widget is inside the group but not inside the dockwidget.
+                // For example, it's a line edit in the QTabBar. We still need to send the signal for
+                // the current dw in the tab group
+                focusedDockWidget = group->currentDockWidget();
+                foundDockWidget = true;
+            } else if (auto dw = p->asDockWidgetController()) {
+                focusedDockWidget = dw;
+                foundDockWidget = true;
             }
-
-            return;
         }
 
-        if (auto dw = p->asDockWidgetController()) {
-            DockRegistry::self()->setFocusedDockWidget(dw);
-            return;
+        if (d->m_focusScopes.empty()) {
+            if (foundDockWidget)
+                break;
+        } else {
+            auto it = d->m_focusScopes.find(p->handle());
+            if (it != d->m_focusScopes.end())
+                focusedScopes.push_back(it->second);
         }
-        p = p->parentView();
     }
 
-    setFocusedDockWidget(nullptr);
+    // Only scopes that lost focus or that contain the focused view are told about it.
+    // Gathered before any callback runs, as callbacks might delete groups
+    struct ScopeChange
+    {
+        Core::FocusScope *scope;
+        const void *handle;
+        bool isInScope;
+    };
+
+    Vector<ScopeChange> changes;
+    for (Core::FocusScope *scope : std::as_const(d->m_focusedScopes)) {
+        if (!focusedScopes.contains(scope))
+            changes.push_back({ scope, scope->viewHandle(), false });
+    }
+
+    for (Core::FocusScope *scope : std::as_const(focusedScopes))
+        changes.push_back({ scope, scope->viewHandle(), true });
+
+    d->m_focusedScopes = std::move(focusedScopes);
+
+    setFocusedDockWidget(focusedDockWidget);
+
+    for (const ScopeChange &change : std::as_const(changes)) {
+        auto it = d->m_focusScopes.find(change.handle);
+        if (it != d->m_focusScopes.end() && it->second == change.scope)
+            change.scope->onFocusedViewChanged(view, change.isInScope);
+    }
+}
+
+void DockRegistry::registerFocusScope(Core::FocusScope *scope)
+{
+    d->m_focusScopes[scope->viewHandle()] = scope;
+    if (scope->isFocused())
+        d->m_focusedScopes.push_back(scope);
+}
+
+void DockRegistry::unregisterFocusScope(Core::FocusScope *scope)
+{
+    auto it = d->m_focusScopes.find(scope->viewHandle());
+    if (it != d->m_focusScopes.end() && it->second == scope)
+        d->m_focusScopes.erase(it);
+
+    d->m_focusedScopes.removeOne(scope);
 }
 
 void DockRegistry::setFocusedDockWidget(Core::DockWidget *dw)
@@ -328,6 +416,7 @@ void DockRegistry::registerDockWidget(Core::DockWidget *dock)
     }
 
     m_dockWidgets.push_back(dock);
+    d->m_dockWidgetsByName.emplace(dock->uniqueName(), dock);
 }
 
 void DockRegistry::unregisterDockWidget(Core::DockWidget *dock)
@@ -335,6 +424,7 @@ void DockRegistry::unregisterDockWidget(Core::DockWidget *dock)
     if (d->m_focusedDockWidget == dock)
         d->m_focusedDockWidget = nullptr;
 
+    removeFromNameIndex(d->m_dockWidgetsByName, m_dockWidgets, dock, dock->uniqueName());
     m_dockWidgets.removeOne(dock);
     m_sideBarGroupings->removeFromGroupings(dock);
 
@@ -350,11 +440,13 @@ void DockRegistry::registerMainWindow(Core::MainWindow *mainWindow)
     }
 
     m_mainWindows.push_back(mainWindow);
+    d->m_mainWindowsByName.emplace(mainWindow->uniqueName(), mainWindow);
     Platform::instance()->onMainWindowCreated(mainWindow);
 }
 
 void DockRegistry::unregisterMainWindow(Core::MainWindow *mainWindow)
 {
+    removeFromNameIndex(d->m_mainWindowsByName, m_mainWindows, mainWindow, mainWindow->uniqueName());
     m_mainWindows.removeOne(mainWindow);
     Platform::instance()->onMainWindowDestroyed(mainWindow);
     maybeDelete();
@@ -384,6 +476,15 @@ void DockRegistry::unregisterGroup(Core::Group *group)
     maybeDelete();
 }
 
+void DockRegistry::onDockWidgetUniqueNameChanged(Core::DockWidget *dock, const QString &oldName)
+{
+    if (!m_dockWidgets.contains(dock))
+        return;
+
+    removeFromNameIndex(d->m_dockWidgetsByName, m_dockWidgets, dock, oldName);
+    d->m_dockWidgetsByName.emplace(dock->uniqueName(), dock);
+}
+
 void DockRegistry::registerLayoutSaver()
 {
     d->m_numLayoutSavers++;
@@ -412,15 +513,14 @@ bool DockRegistry::containsMainWindow(const QString &uniqueName) const
 
 Core::DockWidget *DockRegistry::dockByName(const QString &name, DockByNameFlags flags) const
 {
-    for (auto dock : std::as_const(m_dockWidgets)) {
-        if (dock->uniqueName() == name)
-            return dock;
-    }
+    auto it = d->m_dockWidgetsByName.find(name);
+    if (it != d->m_dockWidgetsByName.cend())
+        return it->second;
 
     if (flags.testFlag(DockByNameFlag::ConsultRemapping)) {
         // Name doesn't exist, let's check if it was remapped during a layout restore.
-        auto it = m_dockWidgetIdRemapping.find(name);
-        const QString newName = it == m_dockWidgetIdRemapping.cend() ? QString() : it->second;
+        auto itRemap = m_dockWidgetIdRemapping.find(name);
+        const QString newName = itRemap == m_dockWidgetIdRemapping.cend() ? QString() : itRemap->second;
         if (!newName.isEmpty())
             return dockByName(newName);
     }
@@ -446,12 +546,8 @@ Core::DockWidget *DockRegistry::dockByName(const QString &name, DockByNameFlags
 
 Core::MainWindow *DockRegistry::mainWindowByName(const QString &name) const
 {
-    for (auto mainWindow : std::as_const(m_mainWindows)) {
-        if (mainWindow->uniqueName() == name)
-            return mainWindow;
-    }
-
-    return nullptr;
+    auto it = d->m_mainWindowsByName.find(name);
+    return it == d->m_mainWindowsByName.cend() ? nullptr : it->second;
 }
 
 bool DockRegistry::isSane() const
@@ -500,8 +596,10 @@ Core::DockWidget::List DockRegistry::dockWidgets(const Vector<QString> &names)
     Core::DockWidget::List result;
     result.reserve(names.size());
 
+    // Keeps registration order, like dockwidgets() does
+    const std::unordered_set<QString> nameSet(names.cbegin(), names.cend());
     for (auto dw : std::as_const(m_dockWidgets)) {
-        if (names.contains(dw->uniqueName()))
+        if (nameSet.find(dw->uniqueName()) != nameSet.cend())
             result.push_back(dw);
     }
 
@@ -513,8 +611,9 @@ Core::MainWindow::List DockRegistry::mainWindows(const Vector<QString> &names)
     Core::MainWindow::List result;
     result.reserve(names.size());
 
+    const std::unordered_set<QString> nameSet(names.cbegin(), names.cend());
     for (auto mw : std::as_const(m_mainWindows)) {
-        if (names.contains(mw->uniqueName()))
+        if (nameSet.find(mw->uniqueName()) != nameSet.cend())
             result.push_back(mw);
     }
 
@@ -577,6 +676,62 @@ Vector<Core::FloatingWindow *> DockRegistry::floatingWindows(bool includeBeingDe
     return result;
 }
 
+Vector<Core::Layout *> DockRegistry::layouts() const
+{
+    Vector<Core::Layout *> result;
+    auto add = [&result](Core::Layout *layout) {
+        if (layout && !result.contains(layout))
+            result.push_back(layout);
+    };
+
+    for (Core::MainWindow *mw : m_mainWindows)
+        add(mw->layout());
+
+    for (Core::FloatingWindow *fw : m_floatingWindows)
+        add(fw->layout());
+
+    // Nested layouts are only reachable through their groups
+    for (Core::Group *group : m_groups) {
+        if (Core::Item *item = group->layoutItem())
+            add(Core::Layout::fromLayoutingHost(item->host()));
+    }
+
+    return result;
+}
+
+PlaceholderCompactionResult DockRegistry::compactPlaceholders(int maxAgeMs, int maxCount)
+{
+    PlaceholderCompactionResult result;
+    if (maxAgeMs < 0 && maxCount < 0)
+        return result;
+
+    for (Core::Layout *layout : layouts())
+        result += layout->compactPlaceholders(maxAgeMs, maxCount);
+
+    if (!result.isEmpty()) {
+        KDDW_DEBUG("DockRegistry::compactPlaceholders: Removed {} placeholders, {} references and {} containers",
+                   result.removedPlaceholders, result.removedReferences, result.removedContainers);
+    }
+
+    return result;
+}
+
+PlaceholderCompactionResult DockRegistry::compactPlaceholders()
+{
+    const Config &config = Config::self();
+    return compactPlaceholders(config.placeholderMaxAge(), config.maxPlaceholdersPerLayout());
+}
+
+void DockRegistry::schedulePlaceholderCompaction()
+{
+    const int interval = Config::self().placeholderCompactionInterval();
+    if (interval < 0 || d->m_placeholderCompactionScheduled)
+        return;
+
+    d->m_placeholderCompactionScheduled = true;
+    Platform::instance()->runDelayed(interval, new DelayedPlaceholderCompaction());
+}
+
 Window::List DockRegistry::floatingQWindows() const
 {
     Window::List windows;
@@ -705,8 +860,8 @@ bool DockRegistry::onMouseButtonPress(View *view, MouseEvent *event)
         // When clicking on a MDI Group we raise the window
         if (Controller *c = view->d->firstParentOfType(ViewType::Group)) {
             auto group = static_cast<Group *>(c);
-            if (group->isMDI())
-                group->view()->raise();
+            if (MDILayout *layout = group->mdiLayout())
+                layout->raiseGroup(group);
         }
     }
 
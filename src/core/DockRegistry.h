@@ -77,6 +77,9 @@ public:
     void registerLayoutSaver();
     void unregisterLayoutSaver();
 
+    /// @brief Called by DockWidget::setUniqueName() so dockByName() keeps working
+    void onDockWidgetUniqueNameChanged(Core::DockWidget *, const QString &oldName);
+
     /// Returns the dock widget that contains the widget with active focus
     /// Doesn't necessarily mean that this DockWidget has QWidget::focus, but that it contains
     /// the QApplication::focusObject() widget.
@@ -127,6 +130,22 @@ public:
     ///@brief returns whether if there's at least one floating window
     Q_INVOKABLE bool hasFloatingWindows() const;
 
+    /// @brief Returns the layouts of all main windows and floating windows, plus the ones
+    /// nested in them, like a drop area inside an MDI area
+    Vector<Core::Layout *> layouts() const;
+
+    /// @brief Calls Layout::compactPlaceholders() on every layout
+    /// Returns what was reclaimed, in total
+    PlaceholderCompactionResult compactPlaceholders(int maxAgeMs, int maxCount);
+
+    /// @brief Overload using the limits from Config::setPlaceholderMaxAge() and
+    /// Config::setMaxPlaceholdersPerLayout()
+    PlaceholderCompactionResult compactPlaceholders();
+
+    /// @brief Schedules a compactPlaceholders() Config::placeholderCompactionInterval()
+    /// milliseconds from now, if enabled. Called whenever a dock widget is closed.
+    void schedulePlaceholderCompaction();
+
     ///@brief returns the FloatingWindow with handle @p windowHandle
     Core::FloatingWindow *
     floatingWindowForHandle(std::shared_ptr<Core::Window> windowHandle) const;
@@ -239,6 +258,8 @@ private:
     void onFocusedViewChanged(std::shared_ptr<Core::View> view);
     void maybeDelete();
     void setFocusedDockWidget(Core::DockWidget *);
+    void registerFocusScope(Core::FocusScope *);
+    void unregisterFocusScope(Core::FocusScope *);
 
     // EventFilterInterface:
     bool onExposeEvent(std::shared_ptr<Core::Window>) override;
@@ -14,6 +14,8 @@
 
 #include <kdbindings/signal.h>
 
+#include <unordered_map>
+
 
 #pragma once
 
@@ -38,9 +40,25 @@ public:
 
     KDBindings::ConnectionHandle m_connection;
 
+    /// @brief The FocusScopes, indexed by the handle of their view
+    /// So a focus change only walks up the focused view's parents once, instead of once per scope.
+    std::unordered_map<const void *, Core::FocusScope *> m_focusScopes;
+
+    /// @brief The FocusScopes which are currently focused, the innermost first
+    Vector<Core::FocusScope *> m_focusedScopes;
+
     int m_numLayoutSavers = 0;
 
+    /// @brief Indexes m_dockWidgets and m_mainWindows by uniqueName, for O(1) lookups
+    /// If there are duplicate names (which is an error) the first registered one is indexed,
+    /// same as a linear search would return.
+    std::unordered_map<QString, Core::DockWidget *> m_dockWidgetsByName;
+    std::unordered_map<QString, Core::MainWindow *> m_mainWindowsByName;
+
     CloseReason m_currentCloseReason = CloseReason::Unspecified;
+
+    /// @brief Whether a DelayedPlaceholderCompaction is pending, see schedulePlaceholderCompaction()
+    bool m_placeholderCompactionScheduled = false;
 };
 
 }
@@ -186,6 +186,8 @@ std::shared_ptr<View> DockWidget::guestView() const
 
 void DockWidget::setGuestView(std::shared_ptr<View> guest)
 {
+    d->guestViewProvider = nullptr;
+
     if ((guest && guest->equals(d->guest)) || (!guest && !d->guest))
         return;
 
@@ -201,6 +203,27 @@ void DockWidget::setGuestView(std::shared_ptr<View> guest)
     d->guestViewChanged.emit();
 }
 
+void DockWidget::setGuestViewProvider(GuestViewProvider provider)
+{
+    d->guestViewProvider = std::move(provider);
+}
+
+bool DockWidget::hasPendingGuestView() const
+{
+    return bool(d->guestViewProvider);
+}
+
+void DockWidget::ensureGuestView()
+{
+    if (!d->guestViewProvider)
+        return;
+
+    // Moved out, so it's only called once, even if it shows us
+    auto provider = std::move(d->guestViewProvider);
+    d->guestViewProvider = nullptr;
+    provider(this);
+}
+
 bool DockWidget::isFloating() const
 {
     if (view()->isRootView())
@@ -439,6 +462,9 @@ void DockWidget::show()
 
 void DockWidget::open()
 {
+    if (!LayoutSaver::restoreInProgress())
+        ensureGuestView();
+
     if (view()->isRootView()
         && (d->m_lastPositions->wasFloating() || d->m_lastPositions->lastItem(this) == nullptr)) {
         // Create the FloatingWindow already, instead of waiting for the show event.
@@ -460,8 +486,8 @@ void DockWidget::raise()
         fw->view()->raise();
         fw->view()->activateWindow();
     } else if (Core::Group *group = d->group()) {
-        if (group->isMDI())
-            group->view()->raise();
+        if (MDILayout *layout = group->mdiLayout())
+            layout->raiseGroup(group);
     }
 }
 
@@ -848,6 +874,9 @@ void DockWidget::Private::close()
         if (Core::SideBar *sb = DockRegistry::self()->sideBarForDockWidget(q)) {
             sb->removeDockWidget(q);
         }
+
+        // Closing leaves a placeholder behind
+        DockRegistry::self()->schedulePlaceholderCompaction();
     }
 
     if (!m_isMovingToSideBar && (options & DockWidgetOption_DeleteOnClose)) {
@@ -1179,8 +1208,10 @@ void DockWidget::Private::setUniqueName(const QString &name)
 {
     if (name.isEmpty()) {
         KDDW_ERROR("DockWidget::Private::setUniqueName: Name is empty");
-    } else {
+    } else if (name != m_uniqueName) {
+        const QString oldName = m_uniqueName;
         m_uniqueName = name;
+        DockRegistry::self()->onDockWidgetUniqueNameChanged(q, oldName);
     }
 }
 
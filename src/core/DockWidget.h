@@ -29,6 +29,7 @@
 #include "kddockwidgets/core/Controller.h"
 #include "kddockwidgets/core/Action.h"
 
+#include <functional>
 #include <memory>
 
 // clazy:excludeall=ctor-missing-parent-argument
@@ -124,6 +125,29 @@ public:
     /// @brief Like widget() but returns a view
     std::shared_ptr<View> guestView() const;
 
+    /// @brief Creates the guest view of a dock widget, see setGuestViewProvider()
+    using GuestViewProvider = std::function<void(DockWidget *)>;
+
+    /**
+     * @brief Defers creating the guest view until it's actually needed
+     *
+     * Instead of calling setGuestView() right away, pass a provider which does it. Until then the
+     * dock widget is a lightweight proxy with its unique name, title and icon. It can be restored
+     * by LayoutSaver, added to side bars and listed in menus, but guestView() returns nullptr.
+     *
+     * The provider is called once, the first time the dock widget is shown, becomes the current
+     * tab or is overlayed from a side bar. Dock widgets which stay closed, or in a tab that's
+     * never made current, never create theirs.
+     * Calling setGuestView() before that drops the provider.
+     */
+    void setGuestViewProvider(GuestViewProvider provider);
+
+    /// @brief Returns whether there's a provider which wasn't called yet
+    bool hasPendingGuestView() const;
+
+    /// @brief Calls the provider right away, if there's one pending
+    void ensureGuestView();
+
     /**
      * @brief Returns whether the dock widget is floating.
      * Floating means it's not docked and has a window of its own.
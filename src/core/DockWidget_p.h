@@ -268,6 +268,7 @@ public:
     Icon titleBarIcon;
     Icon tabBarIcon;
     std::shared_ptr<View> guest;
+    DockWidget::GuestViewProvider guestViewProvider;
     DockWidget *const q;
     DockWidgetOptions options;
     FloatingWindowFlags m_flags = FloatingWindowFlag::FromGlobalConfig;
@@ -11,6 +11,7 @@
 
 #include "DragController_p.h"
 #include "Logging_p.h"
+#include "Profiler_p.h"
 #include "Utils_p.h"
 #include "WidgetResizeHandler_p.h"
 #include "Config.h"
@@ -24,6 +25,7 @@
 #include "core/Platform.h"
 #include "core/Group.h"
 #include "core/FloatingWindow.h"
+#include "core/MainWindow.h"
 #include "core/DockWidget_p.h"
 #include "core/ScopedValueRollback_p.h"
 
@@ -137,6 +139,7 @@ State *MinimalStateMachine::currentState() const
 void MinimalStateMachine::setCurrentState(State *state)
 {
     if (state != m_currentState) {
+        KDDW_PROFILE_SCOPE("DragController::setCurrentState");
         if (m_currentState)
             m_currentState->onExit();
 
@@ -169,6 +172,7 @@ StateNone::StateNone(DragController *parent)
 
 void StateNone::onEntry()
 {
+    KDDW_PROFILE_SCOPE("DragController::StateNone::onEntry");
     KDDW_DEBUG("StateNone entered");
     q->m_pressPos = Point();
     q->m_offset = Point();
@@ -226,6 +230,7 @@ StatePreDrag::~StatePreDrag() = default;
 
 void StatePreDrag::onEntry()
 {
+    KDDW_PROFILE_SCOPE("DragController::StatePreDrag::onEntry");
     KDDW_DEBUG("StatePreDrag entered {}", q->m_draggableGuard.isNull());
     WidgetResizeHandler::s_disableAllHandlers = true; // Disable the resize handler during dragging
 }
@@ -293,6 +298,7 @@ StateDragging::~StateDragging() = default;
 
 void StateDragging::onEntry()
 {
+    KDDW_PROFILE_SCOPE("DragController::StateDragging::onEntry");
 #if defined(KDDW_FRONTEND_QT_WINDOWS) && !defined(DOCKS_DEVELOPER_MODE)
     m_maybeCancelDrag.start();
 #endif
@@ -312,6 +318,17 @@ void StateDragging::onEntry()
 
     const bool needsUndocking = !q->m_draggable->isWindow();
     q->m_windowBeingDragged = q->m_draggable->makeWindow();
+
+    // Index the groups of every potential drop target, so hovering doesn't need to visit them
+    for (Core::MainWindow *mainWindow : DockRegistry::self()->mainwindows()) {
+        if (auto dropArea = mainWindow->dropArea())
+            dropArea->updateGroupIndex();
+    }
+    for (Core::FloatingWindow *fw : DockRegistry::self()->floatingWindows()) {
+        if (q->m_windowBeingDragged && fw == q->m_windowBeingDragged->floatingWindow())
+            continue;
+        fw->dropArea()->updateGroupIndex();
+    }
     if (q->m_windowBeingDragged) {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0) && defined(KDDW_FRONTEND_QT_WINDOWS)
         if (!q->m_nonClientDrag && KDDockWidgets::usesNativeDraggingAndResizing()) {
@@ -511,6 +528,7 @@ StateInternalMDIDragging::~StateInternalMDIDragging()
 
 void StateInternalMDIDragging::onEntry()
 {
+    KDDW_PROFILE_SCOPE("DragController::StateInternalMDIDragging::onEntry");
     KDDW_DEBUG("StateInternalMDIDragging entered. draggable={}", ( void * )q->m_draggable);
 
     if (!q->m_draggableGuard) {
@@ -23,6 +23,7 @@
 #include "core/layouting/LayoutingSeparator_p.h"
 #include "core/WindowBeingDragged_p.h"
 #include "core/DelayedCall_p.h"
+#include "core/SpatialIndex_p.h"
 #include "core/Group.h"
 #include "core/FloatingWindow.h"
 #include "core/DockWidget_p.h"
@@ -79,6 +80,11 @@ public:
     Core::Group *const m_centralGroup = nullptr;
     Core::ItemBoxContainer *m_rootItem = nullptr;
     KDBindings::ScopedConnection m_visibleWidgetCountConnection;
+
+    /// Visible groups by geometry, see groupContainingPos()
+    SpatialIndex<Core::Group *> m_groupIndex;
+    /// The layout generation m_groupIndex was built for. See LayoutingHost::generation()
+    uint64_t m_groupIndexGeneration = 0;
 };
 }
 
@@ -131,10 +137,9 @@ DropArea::~DropArea()
 
 Core::Group::List DropArea::groups() const
 {
-    const Core::Item::List children = d->m_rootItem->items_recursive();
     Core::Group::List groups;
 
-    for (const Core::Item *child : children) {
+    for (const Core::Item *child : d->m_rootItem->itemRange_recursive()) {
         if (auto guest = child->guest()) {
             if (!guest->freed()) {
                 if (auto group = Group::fromItem(child)) {
@@ -149,17 +154,28 @@ Core::Group::List DropArea::groups() const
 
 Core::Group *DropArea::groupContainingPos(Point globalPos) const
 {
-    const Core::Item::List &items = this->items();
-    for (Core::Item *item : items) {
-        auto group = Group::fromItem(item);
-        if (!group || !group->isVisible()) {
-            continue;
-        }
+    // Called for every mouse move while dragging, so use an index instead of visiting every item
+    updateGroupIndex();
 
-        if (group->containsMouse(globalPos))
-            return group;
+    Core::Group *group = d->m_groupIndex.valueAt(view()->mapFromGlobal(globalPos));
+    return group && group->isVisible() ? group : nullptr;
+}
+
+void DropArea::updateGroupIndex() const
+{
+    const uint64_t generation = asLayoutingHost()->generation();
+    if (generation == d->m_groupIndexGeneration)
+        return;
+
+    std::vector<std::pair<Rect, Core::Group *>> entries;
+    for (Core::Item *item : d->m_rootItem->visibleItemRange_recursive()) {
+        // Same geometry Group::containsMouse() uses, in our coordinate space
+        if (auto group = Group::fromItem(item))
+            entries.push_back({ group->view()->geometry(), group });
     }
-    return nullptr;
+
+    d->m_groupIndex.build(std::move(entries));
+    d->m_groupIndexGeneration = generation;
 }
 
 void DropArea::updateFloatingActions()
@@ -171,8 +187,7 @@ void DropArea::updateFloatingActions()
 
 Core::Item *DropArea::centralFrame() const
 {
-    const auto items = this->items();
-    for (Core::Item *item : items) {
+    for (Core::Item *item : d->m_rootItem->itemRange_recursive()) {
         if (auto group = Group::fromItem(item)) {
             if (group->isCentralGroup())
                 return item;
@@ -140,6 +140,11 @@ public:
     /// Returns the current drop location
     /// The user needs to be dragging a window and be over a drop indicator, otherwise DropLocation_None is returned
     DropLocation currentDropLocation() const;
+
+    /// @internal
+    /// Builds the index groupContainingPos() uses to find the hovered group, unless it's up to date.
+    /// Called when a drag starts, so the first hover doesn't pay for it.
+    void updateGroupIndex() const;
 #if defined(DOCKS_DEVELOPER_MODE) || defined(KDDW_FRONTEND_FLUTTER)
 public:
 #else
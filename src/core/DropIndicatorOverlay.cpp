@@ -23,6 +23,7 @@
 
 #include "core/DragController_p.h"
 #include "core/DockRegistry_p.h"
+#include "core/layouting/LayoutingHost_p.h"
 
 using namespace KDDockWidgets;
 using namespace KDDockWidgets::Core;
@@ -260,3 +261,8 @@ Group *DropIndicatorOverlay::hoveredGroup() const
 void DropIndicatorOverlay::updateVisibility()
 {
 }
+
+uint64_t DropIndicatorOverlay::layoutGeneration() const
+{
+    return m_dropArea->asLayoutingHost()->generation();
+}
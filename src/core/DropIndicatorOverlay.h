@@ -16,6 +16,8 @@
 #include "kddockwidgets/KDDockWidgets.h"
 #include "Controller.h"
 
+#include <cstdint>
+
 namespace KDDockWidgets {
 
 namespace Core {
@@ -87,6 +89,10 @@ protected:
     virtual void onHoveredGroupChanged(Group *);
     virtual void updateVisibility();
 
+    /// Returns the drop area's LayoutingHost::generation()
+    /// Hover results cached by subclasses are only valid while this doesn't change.
+    uint64_t layoutGeneration() const;
+
     Group *m_hoveredGroup = nullptr;
     DropArea *const m_dropArea;
     bool m_draggedWindowIsHovering = false;
@@ -604,13 +604,19 @@ bool FloatingWindow::deserialize(const LayoutSaver::FloatingWindow &fw)
 }
 
 LayoutSaver::FloatingWindow FloatingWindow::serialize() const
+{
+    LayoutSaver::FloatingWindow fw = serializeWithoutLayout();
+    fw.multiSplitterLayout = dropArea()->serialize();
+    return fw;
+}
+
+LayoutSaver::FloatingWindow FloatingWindow::serializeWithoutLayout() const
 {
     LayoutSaver::FloatingWindow fw;
 
     fw.geometry = geometry();
     fw.normalGeometry = view()->normalGeometry();
     fw.isVisible = isVisible();
-    fw.multiSplitterLayout = dropArea()->serialize();
     fw.screenIndex = Platform::instance()->screenNumberForView(view());
     fw.screenSize = Platform::instance()->screenSizeFor(view());
     fw.affinities = affinities();
@@ -45,6 +45,8 @@ public:
 
     bool deserialize(const LayoutSaver::FloatingWindow &);
     LayoutSaver::FloatingWindow serialize() const;
+    /// Same as serialize() but leaves multiSplitterLayout empty, for callers which have it cached
+    LayoutSaver::FloatingWindow serializeWithoutLayout() const;
 
     // Draggable:
     std::unique_ptr<WindowBeingDragged> makeWindow() override;
@@ -22,7 +22,6 @@
 #include "core/DockWidget.h"
 #include "core/Group.h"
 #include "DockRegistry.h"
-#include "core/Platform_p.h"
 #include "core/Logging_p.h"
 #include "core/ViewGuard.h"
 #include "View.h"
@@ -37,11 +36,11 @@ public:
     Private(FocusScope *qq, View *thisView)
         : q(qq)
         , m_thisView(thisView)
+        , m_handle(thisView->handle())
     {
-        auto plat = Platform::instance();
-        m_connection = plat->d->focusedViewChanged.connect(&Private::onFocusedViewChanged, this);
-
-        onFocusedViewChanged(plat->focusedView());
+        // Later changes are routed by DockRegistry, see DockRegistry::onFocusedViewChanged()
+        auto focusedView = Platform::instance()->focusedView();
+        onFocusedViewChanged(focusedView, isInFocusScope(focusedView));
 
         // NOLINTNEXTLINE(cppcoreguidelines-prefer-member-initializer)
         m_inCtor = false;
@@ -54,32 +53,34 @@ public:
             && m_lastFocusedInScope->is(ViewType::Stack);
     }
 
-    ~Private();
-
     void setIsFocused(bool);
-    void onFocusedViewChanged(std::shared_ptr<View> view);
+
+    /// @p isInScope tells whether @p view is this scope's view or a descendant of it
+    void onFocusedViewChanged(const std::shared_ptr<View> &view, bool isInScope);
     bool isInFocusScope(std::shared_ptr<View> view) const;
 
     FocusScope *const q;
     ViewGuard m_thisView;
+
+    /// What DockRegistry indexes us by. Kept, as the view might be gone by the time we're destroyed
+    const HANDLE m_handle;
     bool m_isFocused = false;
     bool m_inCtor = true;
     std::shared_ptr<View> m_lastFocusedInScope;
-    KDBindings::ConnectionHandle m_connection;
 };
 
-FocusScope::Private::~Private()
-{
-    m_connection.disconnect();
-}
-
 FocusScope::FocusScope(View *thisView)
     : d(new Private(this, thisView))
 {
+    DockRegistry::self()->registerFocusScope(this);
 }
 
 FocusScope::~FocusScope()
 {
+    // Not creating the registry if it's already gone
+    if (auto registry = DockRegistry::self(/*create=*/false))
+        registry->unregisterFocusScope(this);
+
     delete d;
 }
 
@@ -126,6 +127,16 @@ void FocusScope::focus(Qt::FocusReason reason)
     }
 }
 
+void FocusScope::onFocusedViewChanged(const std::shared_ptr<View> &view, bool isInScope)
+{
+    d->onFocusedViewChanged(view, isInScope);
+}
+
+const void *FocusScope::viewHandle() const
+{
+    return d->m_handle;
+}
+
 void FocusScope::Private::setIsFocused(bool is)
 {
     if (is != m_isFocused) {
@@ -136,22 +147,21 @@ void FocusScope::Private::setIsFocused(bool is)
     }
 }
 
-void FocusScope::Private::onFocusedViewChanged(std::shared_ptr<View> view)
+void FocusScope::Private::onFocusedViewChanged(const std::shared_ptr<View> &view, bool isInScope)
 {
     if (!view || view->isNull()) {
         setIsFocused(false);
         return;
     }
 
-    const bool is = isInFocusScope(view);
     const bool focusViewChanged = !m_lastFocusedInScope || m_lastFocusedInScope->isNull()
         || !m_lastFocusedInScope->equals(view);
-    if (is && focusViewChanged && !view->is(ViewType::TitleBar)) {
+    if (isInScope && focusViewChanged && !view->is(ViewType::TitleBar)) {
         m_lastFocusedInScope = view;
-        setIsFocused(is);
+        setIsFocused(isInScope);
         /* Q_EMIT */ q->focusedWidgetChangedCallback();
     } else {
-        setIsFocused(is);
+        setIsFocused(isInScope);
     }
 }
 
@@ -22,6 +22,12 @@
 #include "kddockwidgets/docks_export.h"
 #include "kddockwidgets/KDDockWidgets.h"
 
+#include <memory>
+
+namespace KDDockWidgets {
+class DockRegistry;
+}
+
 namespace KDDockWidgets::Core {
 
 class View;
@@ -51,6 +57,12 @@ protected:
     virtual void focusedWidgetChangedCallback() = 0;
 
 private:
+    friend class KDDockWidgets::DockRegistry;
+
+    // Called by DockRegistry, which routes focus changes to the affected scopes only
+    void onFocusedViewChanged(const std::shared_ptr<View> &view, bool isInScope);
+    const void *viewHandle() const;
+
     class Private;
     Private *const d;
 };
@@ -101,6 +101,7 @@ Group::Group(View *parent, FrameOptions options, int userType)
 
     m_tabBar->dptr()->currentDockWidgetChanged.connect([this] {
         updateTitleAndIcon();
+        d->markLayoutDirty();
     });
 
     setLayout(parent ? parent->asLayout() : nullptr);
@@ -426,6 +427,7 @@ void Group::onDockWidgetCountChanged()
         }
     }
 
+    d->markLayoutDirty();
     safeEmitSignal(d->numDockWidgetsChanged);
 }
 
@@ -642,6 +644,12 @@ LayoutingHost *Group::Private::host() const
     return q->m_layout ? q->m_layout->asLayoutingHost() : nullptr;
 }
 
+void Group::Private::markLayoutDirty() const
+{
+    if (auto h = host())
+        h->markDirty();
+}
+
 void Group::Private::setHost(LayoutingHost *host)
 {
     Core::View *parent = nullptr;
@@ -61,6 +61,10 @@ public:
     LayoutingHost *host() const override;
     void setHost(LayoutingHost *) override;
 
+    /// Our tabs are part of the serialized layout, so changing them invalidates it.
+    /// See LayoutingHost::generation()
+    void markLayoutDirty() const;
+
     Size minSize() const override
     {
         return q->view()->minSize();
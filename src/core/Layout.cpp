@@ -25,8 +25,11 @@
 #include "Group.h"
 #include "FloatingWindow.h"
 #include "MainWindow.h"
+#include "DockRegistry.h"
+#include "ObjectGuard_p.h"
 #include "layouting/Item_p.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 using namespace KDDockWidgets;
@@ -61,6 +64,8 @@ void Layout::viewAboutToBeDeleted()
             d->m_rootItem = nullptr;
         }
 
+        d->clearRecycledSeparators();
+
         d->m_viewDeleted = true;
     }
 }
@@ -237,9 +242,10 @@ Core::Item *Layout::itemForGroup(const Core::Group *group) const
 Core::DockWidget::List Layout::dockWidgets() const
 {
     Core::DockWidget::List dockWidgets;
-    const Core::Group::List groups = this->groups();
-    for (Core::Group *group : groups)
-        dockWidgets.append(group->dockWidgets());
+    for (Core::Item *item : d->m_rootItem->itemRange_recursive()) {
+        if (auto group = Group::fromItem(item))
+            dockWidgets.append(group->dockWidgets());
+    }
 
     return dockWidgets;
 }
@@ -257,12 +263,10 @@ Core::Group::List Layout::groupsFrom(View *groupOrMultiSplitter) const
 
 Core::Group::List Layout::groups() const
 {
-    const Core::Item::List items = d->m_rootItem->items_recursive();
-
     Core::Group::List result;
-    result.reserve(items.size());
+    result.reserve(30);
 
-    for (Core::Item *item : items) {
+    for (Core::Item *item : d->m_rootItem->itemRange_recursive()) {
         if (auto group = Group::fromItem(item)) {
             result.push_back(group);
         }
@@ -281,6 +285,92 @@ void Layout::removeItem(Core::Item *item)
     item->parentContainer()->removeItem(item);
 }
 
+PlaceholderCompactionResult Layout::compactPlaceholders(int maxAgeMs, int maxCount)
+{
+    PlaceholderCompactionResult result;
+
+    // MDI layouts don't have placeholders
+    auto root = object_cast<ItemBoxContainer *>(d->m_rootItem);
+    if (!root || LayoutSaver::restoreInProgress())
+        return result;
+
+    Vector<Item *> placeholders;
+    root->visit_recursive([&placeholders](Item *item) {
+        if (item->isPlaceholder() && !item->guest() && !item->isBeingInserted())
+            placeholders.push_back(item);
+        return true;
+    });
+
+    // Oldest first
+    std::stable_sort(placeholders.begin(), placeholders.end(), [](Item *item1, Item *item2) {
+        return item1->placeholderSince() < item2->placeholderSince();
+    });
+
+    const auto now = std::chrono::steady_clock::now();
+    const int numExcess = maxCount >= 0 ? std::max(0, int(placeholders.size()) - maxCount) : 0;
+
+    // Guarded, as removing an item can delete its neighbours' containers, but never other items
+    Vector<ObjectGuard<Item>> toRemove;
+    for (int i = 0; i < placeholders.size(); ++i) {
+        Item *item = placeholders.at(i);
+        const bool isTooOld = maxAgeMs >= 0
+            && now - item->placeholderSince() > std::chrono::milliseconds(maxAgeMs);
+        if (i < numExcess || isTooOld)
+            toRemove.push_back(item);
+    }
+
+    if (toRemove.isEmpty())
+        return result;
+
+    const int numContainersBefore = root->containerCount_recursive();
+
+    // Which dock widgets reference each placeholder. Built in a single pass, as each dock widget
+    // only references a couple of items.
+    std::unordered_map<Item *, Vector<Positions::Ptr>> references;
+    for (const ObjectGuard<Item> &item : std::as_const(toRemove))
+        references[item.data()];
+
+    const auto dockWidgets = DockRegistry::self()->dockwidgets();
+    for (Core::DockWidget *dw : dockWidgets) {
+        const Positions::Ptr &positions = dw->d->lastPosition();
+        const auto items = positions->placeholderItems();
+        for (Item *item : items) {
+            auto it = references.find(item);
+            if (it != references.end())
+                it->second.push_back(positions);
+        }
+    }
+
+    for (const ObjectGuard<Item> &item : std::as_const(toRemove)) {
+        if (!item)
+            continue;
+
+        // Dropping the last reference deletes the item, see Item::unref()
+        for (const Positions::Ptr &positions : std::as_const(references[item.data()])) {
+            positions->removePlaceholder(item);
+            ++result.removedReferences;
+            if (!item)
+                break;
+        }
+
+        if (item && item->refCount() > 0) {
+            // Referenced by something other than a dock widget, leave it alone
+            continue;
+        }
+
+        if (item)
+            item->parentContainer()->removeItem(item);
+
+        ++result.removedPlaceholders;
+    }
+
+    root->collapseRedundantContainers();
+    result.removedContainers = numContainersBefore - root->containerCount_recursive();
+    updateSizeConstraints();
+
+    return result;
+}
+
 void Layout::updateSizeConstraints()
 {
     const Size newMinSize = d->m_rootItem->minSize();
@@ -326,13 +416,9 @@ LayoutSaver::MultiSplitter Layout::serialize() const
 {
     LayoutSaver::MultiSplitter l;
     d->m_rootItem->to_json(l.layout);
-    const Core::Item::List items = d->m_rootItem->items_recursive();
-    l.groups.reserve(size_t(items.size()));
-    for (Core::Item *item : items) {
-        if (!item->isContainer()) {
-            if (auto group = Group::fromItem(item)) {
-                l.groups[group->view()->d->id()] = group->serialize();
-            }
+    for (Core::Item *item : d->m_rootItem->itemRange_recursive()) {
+        if (auto group = Group::fromItem(item)) {
+            l.groups[group->view()->d->id()] = group->serialize();
         }
     }
 
@@ -178,6 +178,18 @@ public:
      */
     void removeItem(Core::Item *item);
 
+    /**
+     * @brief Removes placeholders of closed dock widgets, so they're not restored there anymore.
+     *
+     * Placeholders hidden for longer than @p maxAgeMs are removed, then the oldest ones
+     * until at most @p maxCount remain. Pass -1 for no limit.
+     * Containers which become empty or redundant are collapsed.
+     * Does nothing while a layout is being restored.
+     *
+     * @sa DockRegistry::compactPlaceholders()
+     */
+    PlaceholderCompactionResult compactPlaceholders(int maxAgeMs, int maxCount);
+
     /**
      * @brief Updates the min size of this layout.
      */
@@ -18,9 +18,11 @@
 #include "core/Window_p.h"
 #include "nlohmann_helpers_p.h"
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <map>
+#include <vector>
 
 /**
  * Bump whenever the format changes, so we can still load old layouts.
@@ -35,6 +37,7 @@ namespace KDDockWidgets {
 
 namespace Core {
 class FloatingWindow;
+class Layout;
 class View;
 }
 
@@ -290,6 +293,20 @@ public:
     QByteArray toJson() const;
     bool fromJson(const QByteArray &jsonData);
 
+    /// Same document as toJson(), but CBOR encoded. Prefixed with the CBOR self-describe tag, so
+    /// it can be told apart from JSON.
+    QByteArray toBinary() const;
+    bool fromBinary(const QByteArray &binaryData);
+
+    /// Calls fromBinary() or fromJson(), depending on what @p data looks like
+    bool fromJsonOrBinary(const QByteArray &data);
+
+    /// Same as fromJson(), but from an already parsed document
+    bool fromJsonDocument(const nlohmann::json &json);
+
+    /// Returns whether @p data was produced by toBinary()
+    static bool isBinary(const QByteArray &data);
+
     /// Iterates through the layout and patches all absolute sizes. See
     /// RestoreOption_RelativeToMainWindow.
     void scaleSizes(KDDockWidgets::InternalRestoreOptions);
@@ -330,6 +347,13 @@ public:
     static void restorePendingPositions(Core::DockWidget *);
 
     bool matchesAffinity(const Vector<QString> &affinities) const;
+
+    /// Fills @p layout with the current state, shared by the JSON and binary serializers
+    bool serializeLayout(LayoutSaver::Layout &layout) const;
+
+    /// Same as serializeLayout(), but directly to JSON and reusing the parts of the previous
+    /// snapshot that didn't change. See LayoutSaver::serializeLayoutIncremental()
+    bool serializeLayoutSnapshot(nlohmann::json &json);
     void floatWidgetsWhichSkipRestore(const Vector<QString> &mainWindowNames);
     void floatUnknownWidgets(const LayoutSaver::Layout &layout);
 
@@ -338,10 +362,27 @@ public:
     void deleteEmptyGroups() const;
     void clearRestoredProperty();
 
+    /// Parses and validates @p data into @p layout.
+    /// Goes through s_fileCache if it was read from a file by restoreFromFile()
+    bool loadLayout(const QByteArray &data, LayoutSaver::Layout &layout) const;
+
+    /// Same as loadLayout(), but reuses the cached document if @p filename didn't change,
+    /// and caches it otherwise. If @p data is empty the file is only read when needed.
+    static bool loadCachedLayout(const QString &filename, const QByteArray &data, LayoutSaver::Layout &layout);
+
+    /// Returns whether @p filename is cached and, judging by its modification time and size, didn't
+    /// change since. Doesn't read the file.
+    static bool isCachedAndUnchanged(const QString &filename);
+
     DockRegistry *const m_dockRegistry;
     InternalRestoreOptions m_restoreOptions = {};
     Vector<QString> m_affinityNames;
 
+    /// The file restoreFromFile() is restoring, if any
+    QString m_fileBeingRestored;
+    /// Whether restoreFromFile() didn't read m_fileBeingRestored, as it's cached
+    bool m_fileBeingRestoredIsCached = false;
+
     /// If a layout is restored but the dock widget doesn't exist, we store its last position here
     /// so when we create the dock widget we can finally restore
     static std::unordered_map<QString, std::shared_ptr<KDDockWidgets::Positions>> s_unrestoredPositions;
@@ -351,6 +392,104 @@ public:
     static std::unordered_map<QString, CloseReason> s_unrestoredProperties;
 
     static bool s_restoreInProgress;
+
+    /// What serializeLayoutSnapshot() kept from the previous snapshot
+    struct SnapshotCache
+    {
+        struct LayoutEntry
+        {
+            uint64_t generation = 0;
+            nlohmann::json serialized;
+        };
+
+        struct PlaceholdersEntry
+        {
+            std::vector<uint64_t> key;
+            LayoutSaver::Placeholder::List placeholders;
+        };
+
+        /// Keyed by pointer, the generation is what tells if it's still valid
+        std::unordered_map<const Core::Layout *, LayoutEntry> layouts;
+        std::unordered_map<const Positions *, PlaceholdersEntry> placeholders;
+
+        /// The last snapshot, which serializeLayoutPatch() diffs against
+        nlohmann::json lastSnapshot = nlohmann::json::object();
+    };
+
+    SnapshotCache m_snapshotCache;
+
+    /// Layout files which were already parsed and validated, see Config::setLayoutFileCacheSize()
+    struct FileCache
+    {
+        /// What tells if a file changed, without reading it
+        struct Stamp
+        {
+            int64_t modificationTime = 0;
+            int64_t size = -1;
+
+            /// Modified so recently that a change within the modification time's resolution
+            /// wouldn't show. The contents need to be compared then.
+            bool isRecent = true;
+
+            bool isValid() const
+            {
+                return size >= 0;
+            }
+
+            bool operator==(const Stamp &other) const
+            {
+                return modificationTime == other.modificationTime && size == other.size;
+            }
+
+            bool operator!=(const Stamp &other) const
+            {
+                return !(*this == other);
+            }
+        };
+
+        /// Returns the modification time and size of @p filename, invalid for files which aren't
+        /// on disk, like Qt resources
+        static Stamp stampForFile(const QString &filename);
+
+        struct Entry
+        {
+            Stamp stamp;
+
+            /// Only compared if the stamp can't tell, see needsHash()
+            size_t hash = 0;
+
+            /// The size of the file's contents, which is what's accounted for
+            int64_t size = 0;
+
+            /// isValid() depends on it, see Config::setLayoutSaverStrictMode()
+            bool strictMode = false;
+
+            /// The layout as it was after validating, so fix-ups done by isValid() aren't lost
+            nlohmann::json document;
+            uint64_t lastUsed = 0;
+
+            bool needsHash() const
+            {
+                return !stamp.isValid() || stamp.isRecent;
+            }
+        };
+
+        /// Returns the entry for @p filename if it matches @p stamp and the current strict mode,
+        /// nullptr otherwise. Its hash still needs to be compared if needsHash() is true.
+        Entry *find(const QString &filename, const Stamp &stamp);
+
+        /// Adds or replaces the entry for @p filename, then evicts the least recently used
+        /// entries until they fit in Config::layoutFileCacheSize()
+        void insert(const QString &filename, Entry entry);
+
+        void clear();
+
+        std::unordered_map<QString, Entry> entries;
+        int64_t totalSize = 0;
+        uint64_t useCounter = 0;
+    };
+
+    static FileCache s_fileCache;
 };
 }
 
@@ -121,3 +121,43 @@ void MDILayout::resizeDockWidget(Core::Group *group, Size size)
 
     item->setSize(size.expandedTo(group->view()->minSize()));
 }
+
+void MDILayout::raiseGroup(Core::Group *group)
+{
+    if (!group)
+        return;
+
+    group->view()->raise();
+
+    if (Core::Item *item = itemForGroup(group))
+        m_rootItem->raiseItem(item);
+}
+
+Core::Group *MDILayout::groupAt(Point localPos) const
+{
+    return Core::Group::fromItem(m_rootItem->itemAt(localPos));
+}
+
+Vector<Core::Group *> MDILayout::groupsIntersecting(Rect localRect) const
+{
+    Vector<Core::Group *> groups;
+    for (Core::Item *item : m_rootItem->itemsIntersecting(localRect)) {
+        if (auto group = Core::Group::fromItem(item))
+            groups.push_back(group);
+    }
+
+    return groups;
+}
+
+Vector<Core::Group *> MDILayout::groupsInStackingOrder() const
+{
+    Vector<Core::Group *> groups;
+    for (Core::Item *item : m_rootItem->childItems()) {
+        if (item->isVisible()) {
+            if (auto group = Core::Group::fromItem(item))
+                groups.push_back(group);
+        }
+    }
+
+    return groups;
+}
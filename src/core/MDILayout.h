@@ -57,6 +57,20 @@ public:
     /// @brief sets the size and position of the dock widget @p group
     void setDockWidgetGeometry(Core::Group *group, Rect);
 
+    /// @brief Raises @p group above the other MDI windows
+    /// Unlike calling View::raise() directly, this also updates the queries below.
+    void raiseGroup(Core::Group *group);
+
+    /// @brief Returns the top-most group containing @p localPos, in this layout's coordinates
+    /// Doesn't visit every group, so it's cheap even with many MDI windows.
+    Core::Group *groupAt(Point localPos) const;
+
+    /// @brief Returns the groups intersecting @p localRect, top-most first
+    Vector<Core::Group *> groupsIntersecting(Rect localRect) const;
+
+    /// @brief Returns the groups in stacking order, bottom-most first
+    Vector<Core::Group *> groupsInStackingOrder() const;
+
 private:
     Core::ItemFreeContainer *const m_rootItem;
 };
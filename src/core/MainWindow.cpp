@@ -777,6 +777,13 @@ bool MainWindow::deserialize(const LayoutSaver::MainWindow &mw)
 }
 
 LayoutSaver::MainWindow MainWindow::serialize() const
+{
+    LayoutSaver::MainWindow m = serializeWithoutLayout();
+    m.multiSplitterLayout = layout()->serialize();
+    return m;
+}
+
+LayoutSaver::MainWindow MainWindow::serializeWithoutLayout() const
 {
     LayoutSaver::MainWindow m;
 
@@ -789,7 +796,6 @@ LayoutSaver::MainWindow MainWindow::serialize() const
     m.uniqueName = uniqueName();
     m.screenIndex = Platform::instance()->screenNumberForView(view());
     m.screenSize = Platform::instance()->screenSizeFor(view());
-    m.multiSplitterLayout = layout()->serialize();
     m.affinities = d->affinities;
     m.windowState = window ? window->windowState() : WindowState::None;
 
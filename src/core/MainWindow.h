@@ -283,6 +283,8 @@ private:
     friend class KDDockWidgets::LayoutSaver;
     bool deserialize(const LayoutSaver::MainWindow &);
     LayoutSaver::MainWindow serialize() const;
+    /// Same as serialize() but leaves multiSplitterLayout empty, for callers which have it cached
+    LayoutSaver::MainWindow serializeWithoutLayout() const;
 };
 }
 }
@@ -0,0 +1,264 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "MemoryReport.h"
+#include "DockRegistry.h"
+#include "DockWidget_p.h"
+#include "FloatingWindow_p.h"
+#include "Group_p.h"
+#include "Layout_p.h"
+#include "MainWindow.h"
+#include "Position_p.h"
+#include "Stack.h"
+#include "TabBar_p.h"
+#include "TitleBar_p.h"
+#include "View_p.h"
+#include "nlohmann_helpers_p.h"
+#include "core/Controller_p.h"
+#include "core/Separator.h"
+#include "core/layouting/Item_p.h"
+#include "core/layouting/LayoutingSeparator_p.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Core;
+
+namespace {
+
+std::string itemDescription(const Item *item)
+{
+    std::ostringstream stream;
+    stream << "Item " << static_cast<const void *>(item);
+    if (!item->objectName().isEmpty())
+        stream << " (" << item->objectName().toStdString() << ")";
+
+    return stream.str();
+}
+
+}
+
+void MemoryReport::add(const QString &className, int64_t bytes, int count)
+{
+    for (Entry &e : m_entries) {
+        if (e.className == className) {
+            e.count += count;
+            e.estimatedBytes += bytes * count;
+            return;
+        }
+    }
+
+    Entry e;
+    e.className = className;
+    e.count = count;
+    e.estimatedBytes = bytes * count;
+    m_entries.push_back(e);
+}
+
+MemoryReport MemoryReport::collect()
+{
+    MemoryReport report;
+    DockRegistry *registry = DockRegistry::self();
+
+    auto addLeak = [&report](const std::string &description) {
+        report.m_leakedPlaceholders.push_back(QString::fromStdString(description));
+    };
+
+    auto addController = [&report](const Controller *controller, const QString &className, size_t bytes) {
+        if (!controller)
+            return;
+
+        report.add(className, int64_t(bytes + sizeof(Controller::Private)));
+        if (controller->view())
+            report.add(QStringLiteral("View"), int64_t(sizeof(View) + sizeof(View::Private)));
+    };
+
+    for (MainWindow *mw : registry->mainwindows())
+        addController(mw, QStringLiteral("MainWindow"), sizeof(MainWindow));
+
+    for (FloatingWindow *fw : registry->floatingWindows(/*includeBeingDeleted=*/true)) {
+        addController(fw, QStringLiteral("FloatingWindow"),
+                      sizeof(FloatingWindow) + sizeof(FloatingWindow::Private));
+        addController(fw->titleBar(), QStringLiteral("TitleBar"),
+                      sizeof(TitleBar) + sizeof(TitleBar::Private));
+    }
+
+    for (Group *group : registry->groups()) {
+        addController(group, QStringLiteral("Group"), sizeof(Group) + sizeof(Group::Private));
+        addController(group->titleBar(), QStringLiteral("TitleBar"),
+                      sizeof(TitleBar) + sizeof(TitleBar::Private));
+        addController(group->stack(), QStringLiteral("Stack"), sizeof(Stack));
+        addController(group->tabBar(), QStringLiteral("TabBar"),
+                      sizeof(TabBar) + sizeof(TabBar::Private));
+    }
+
+    const Vector<Layout *> layouts = registry->layouts();
+    for (Layout *layout : layouts) {
+        addController(layout, layout->asMDILayout() ? QStringLiteral("MDILayout") : QStringLiteral("DropArea"),
+                      sizeof(Layout) + sizeof(Layout::Private));
+
+        const int numRecycled = layout->d_ptr()->numRecycledSeparators();
+        if (numRecycled > 0)
+            report.add(QStringLiteral("Separator (recycled)"),
+                       int64_t(sizeof(Separator) + sizeof(Controller::Private) + sizeof(LayoutingSeparator)), numRecycled);
+
+        ItemContainer *root = layout->rootItem();
+        if (!root)
+            continue;
+
+        Vector<Item *> pending = { root };
+        while (!pending.isEmpty()) {
+            Item *item = pending.takeLast();
+
+            // SizingInfo is reported on its own, as it's what grows when items are added
+            report.add(QStringLiteral("SizingInfo"), int64_t(sizeof(SizingInfo)));
+
+            if (auto container = object_cast<ItemBoxContainer *>(item)) {
+                report.add(QStringLiteral("ItemBoxContainer"),
+                           int64_t(sizeof(ItemBoxContainer) - sizeof(SizingInfo)));
+                const int numSeparators = container->separators().size();
+                if (numSeparators > 0)
+                    report.add(QStringLiteral("Separator"),
+                               int64_t(sizeof(Separator) + sizeof(Controller::Private) + sizeof(LayoutingSeparator)),
+                               numSeparators);
+            } else if (item->isContainer()) {
+                report.add(QStringLiteral("ItemFreeContainer"),
+                           int64_t(sizeof(ItemContainer) - sizeof(SizingInfo)));
+            } else {
+                report.add(item->isPlaceholder() ? QStringLiteral("Item (placeholder)") : QStringLiteral("Item"),
+                           int64_t(sizeof(Item) - sizeof(SizingInfo)));
+
+                // Positions are the only ones holding refs, so a hidden item without any is
+                // unreachable, nothing will ever restore a dock widget into it
+                if (item->isPlaceholder() && item->refCount() == 0)
+                    addLeak(itemDescription(item) + " is a placeholder with refCount 0");
+            }
+
+            if (item->isContainer()) {
+                for (Item *child : static_cast<ItemContainer *>(item)->childItems())
+                    pending.push_back(child);
+            }
+        }
+    }
+
+    for (DockWidget *dw : registry->dockwidgets()) {
+        addController(dw, QStringLiteral("DockWidget"), sizeof(DockWidget) + sizeof(DockWidget::Private));
+
+        const Positions::Ptr &positions = dw->dptr()->lastPosition();
+        if (!positions)
+            continue;
+
+        report.add(QStringLiteral("Positions"), int64_t(sizeof(Positions)));
+
+        const Vector<Item *> placeholders = positions->placeholderItems();
+        if (!placeholders.isEmpty())
+            report.add(QStringLiteral("Positions placeholder"), int64_t(Positions::placeholderRefSize()),
+                       placeholders.size());
+
+        for (Item *item : placeholders) {
+            if (!item) {
+                addLeak("Positions of " + dw->uniqueName().toStdString() + " references an Item that was destroyed");
+                continue;
+            }
+
+            Layout *layout = item->host() ? Layout::fromLayoutingHost(item->host()) : nullptr;
+            if (!layout || !layouts.contains(layout)) {
+                addLeak("Positions of " + dw->uniqueName().toStdString() + " references "
+                        + itemDescription(item) + ", whose layout is gone");
+            } else if (!layout->rootItem() || !layout->rootItem()->contains_recursive(item)) {
+                addLeak("Positions of " + dw->uniqueName().toStdString() + " references "
+                        + itemDescription(item) + ", which isn't in its layout anymore");
+            }
+        }
+    }
+
+    std::sort(report.m_entries.begin(), report.m_entries.end(), [](const Entry &e1, const Entry &e2) {
+        if (e1.estimatedBytes != e2.estimatedBytes)
+            return e1.estimatedBytes > e2.estimatedBytes;
+        return e1.className < e2.className;
+    });
+
+    return report;
+}
+
+Vector<MemoryReport::Entry> MemoryReport::entries() const
+{
+    return m_entries;
+}
+
+MemoryReport::Entry MemoryReport::entry(const QString &className) const
+{
+    for (const Entry &e : m_entries) {
+        if (e.className == className)
+            return e;
+    }
+
+    Entry e;
+    e.className = className;
+    return e;
+}
+
+int64_t MemoryReport::totalEstimatedBytes() const
+{
+    int64_t total = 0;
+    for (const Entry &e : m_entries)
+        total += e.estimatedBytes;
+
+    return total;
+}
+
+Vector<QString> MemoryReport::leakedPlaceholders() const
+{
+    return m_leakedPlaceholders;
+}
+
+QString MemoryReport::toString() const
+{
+    std::ostringstream stream;
+    for (const Entry &e : m_entries)
+        stream << e.className.toStdString() << ": " << e.count << " objects, ~" << e.estimatedBytes << " bytes\n";
+
+    stream << "Total: ~" << totalEstimatedBytes() << " bytes\n";
+
+    if (m_leakedPlaceholders.isEmpty()) {
+        stream << "No leaked placeholders\n";
+    } else {
+        stream << m_leakedPlaceholders.size() << " leaked placeholders:\n";
+        for (const QString &leak : m_leakedPlaceholders)
+            stream << "    " << leak.toStdString() << "\n";
+    }
+
+    return QString::fromStdString(stream.str());
+}
+
+QByteArray MemoryReport::toJson() const
+{
+    nlohmann::json entries = nlohmann::json::array();
+    for (const Entry &e : m_entries) {
+        nlohmann::json entry;
+        entry["className"] = e.className;
+        entry["count"] = e.count;
+        entry["estimatedBytes"] = e.estimatedBytes;
+        entries.push_back(std::move(entry));
+    }
+
+    nlohmann::json json;
+    json["entries"] = std::move(entries);
+    json["totalEstimatedBytes"] = totalEstimatedBytes();
+    nlohmann::json leaks = nlohmann::json::array();
+    for (const QString &leak : m_leakedPlaceholders)
+        leaks.push_back(leak.toStdString());
+
+    json["leakedPlaceholders"] = std::move(leaks);
+
+    return QByteArray::fromStdString(json.dump());
+}
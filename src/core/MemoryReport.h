@@ -0,0 +1,86 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/**
+ * @file
+ * @brief Snapshot of how much memory the docking hierarchy uses
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#ifndef KD_DOCKWIDGETS_MEMORYREPORT_H
+#define KD_DOCKWIDGETS_MEMORYREPORT_H
+
+#include "kddockwidgets/docks_export.h"
+#include "kddockwidgets/KDDockWidgets.h"
+#include "kddockwidgets/QtCompat_p.h"
+
+#include <cstdint>
+
+namespace KDDockWidgets::Core {
+
+/// @brief Counts the objects KDDW is keeping alive and estimates what they cost
+///
+/// collect() walks every main window, floating window, group and dock widget known to the
+/// DockRegistry, including the layout Items of each layout and the placeholders remembered
+/// by each dock widget's last positions.
+///
+/// Byte counts are estimates: sizeof() of each object plus its private data, when core knows
+/// it. Heap memory owned by containers and whatever a frontend adds to its views isn't counted,
+/// so treat them as lower bounds, useful to compare two snapshots of the same session.
+///
+/// It also reports placeholders which look leaked: hidden Items nobody holds a reference to
+/// anymore, and dock widget positions pointing to Items that were destroyed or whose layout is
+/// gone. Growing counts with no leaks usually mean placeholders are accumulating legitimately,
+/// for example because dock widgets were closed in many different layouts.
+class DOCKS_EXPORT MemoryReport
+{
+public:
+    /// @brief The objects of a single class
+    struct Entry
+    {
+        /// For example "Item" or "Positions placeholder"
+        QString className;
+        int count = 0;
+        int64_t estimatedBytes = 0;
+    };
+
+    /// @brief Walks the DockRegistry and returns the current report
+    static MemoryReport collect();
+
+    /// @brief Returns an entry per class, the most expensive first
+    Vector<Entry> entries() const;
+
+    /// @brief Returns the entry for @p className, an empty one if there isn't any
+    Entry entry(const QString &className) const;
+
+    /// @brief Sum of all estimatedBytes
+    int64_t totalEstimatedBytes() const;
+
+    /// @brief Returns a human readable description of each placeholder that looks leaked
+    Vector<QString> leakedPlaceholders() const;
+
+    /// @brief Returns the report as a table, suitable for printing
+    QString toString() const;
+
+    /// @brief Returns the report as JSON
+    QByteArray toJson() const;
+
+private:
+    void add(const QString &className, int64_t bytes, int count = 1);
+
+    Vector<Entry> m_entries;
+    Vector<QString> m_leakedPlaceholders;
+};
+
+}
+
+#endif
@@ -33,6 +33,14 @@
 
 using namespace KDDockWidgets;
 
+/// Source for Positions::m_generation, so a new instance never reuses the value of a deleted one
+static uint64_t s_lastPositionsGeneration = 0;
+
+Positions::Positions()
+    : m_generation(++s_lastPositionsGeneration)
+{
+}
+
 Positions::~Positions()
 {
     m_placeholders.clear();
@@ -56,6 +64,7 @@ void Positions::addPlaceholderItem(Core::Item *placeholder)
     auto conn = placeholder->deleted.connect([this, placeholder] { removePlaceholder(placeholder); });
 
     m_placeholders.push_back(std::make_unique<ItemRef>(conn, placeholder));
+    markPlaceholdersChanged();
 
     // NOTE: We use a list instead of simply two variables to keep the placeholders, because
     // a placeholder from a FloatingWindow might become a MainWindow one without we knowing,
@@ -115,6 +124,7 @@ void Positions::removePlaceholders()
 {
     ScopedValueRollback clearGuard(m_clearing, true);
     m_placeholders.clear();
+    markPlaceholdersChanged();
 }
 
 void Positions::removePlaceholders(const Core::LayoutingHost *host)
@@ -126,6 +136,7 @@ void Positions::removePlaceholders(const Core::LayoutingHost *host)
                                             return host == itemref->item->host();
                                         }),
                          m_placeholders.end());
+    markPlaceholdersChanged();
 }
 
 void Positions::removeNonMainWindowPlaceholders()
@@ -138,6 +149,8 @@ void Positions::removeNonMainWindowPlaceholders()
         else
             ++it;
     }
+
+    markPlaceholdersChanged();
 }
 
 void Positions::removeMainWindowPlaceholders()
@@ -150,6 +163,8 @@ void Positions::removeMainWindowPlaceholders()
         else
             ++it;
     }
+
+    markPlaceholdersChanged();
 }
 
 void Positions::removePlaceholder(Core::Item *placeholder)
@@ -162,6 +177,12 @@ void Positions::removePlaceholder(Core::Item *placeholder)
                                             return itemref->item == placeholder || !itemref->item;
                                         }),
                          m_placeholders.end());
+    markPlaceholdersChanged();
+}
+
+void Positions::markPlaceholdersChanged()
+{
+    m_generation = ++s_lastPositionsGeneration;
 }
 
 int Positions::placeholderCount() const
@@ -169,6 +190,21 @@ int Positions::placeholderCount() const
     return int(m_placeholders.size());
 }
 
+Vector<Core::Item *> Positions::placeholderItems() const
+{
+    Vector<Core::Item *> result;
+    result.reserve(int(m_placeholders.size()));
+    for (const auto &itemRef : m_placeholders)
+        result.push_back(itemRef->item.data());
+
+    return result;
+}
+
+size_t Positions::placeholderRefSize()
+{
+    return sizeof(ItemRef) + sizeof(std::unique_ptr<ItemRef>);
+}
+
 void Positions::deserialize(const LayoutSaver::Position &lp)
 {
     m_lastFloatingGeometry = lp.lastFloatingGeometry;
@@ -208,9 +244,18 @@ void Positions::deserialize(const LayoutSaver::Position &lp)
             layout = mainWindow->layout();
         }
 
-        const Core::Item::List &items = layout->items();
-        if (itemIndex >= 0 && itemIndex < items.size()) {
-            Core::Item *item = items.at(itemIndex);
+        Core::Item *item = nullptr;
+        if (itemIndex >= 0) {
+            int index = 0;
+            layout->rootItem()->visit_recursive([&index, &item, itemIndex](Core::Item *candidate) {
+                if (index++ < itemIndex)
+                    return true;
+                item = candidate;
+                return false;
+            });
+        }
+
+        if (item) {
             addPlaceholderItem(item);
         } else {
             // Shouldn't happen, maybe even assert
@@ -223,15 +268,44 @@ void Positions::deserialize(const LayoutSaver::Position &lp)
 }
 
 LayoutSaver::Position Positions::serialize() const
+{
+    LayoutSaver::Position l = serializeWithoutPlaceholders();
+    l.placeholders = serializePlaceholders();
+    return l;
+}
+
+LayoutSaver::Position Positions::serializeWithoutPlaceholders() const
 {
     LayoutSaver::Position l;
+    l.tabIndex = m_tabIndex;
+    l.wasFloating = m_wasFloating;
+
+    l.lastFloatingGeometry = lastFloatingGeometry();
+    l.lastOverlayedGeometries = m_lastOverlayedGeometries;
+
+    return l;
+}
+
+Vector<LayoutSaver::Placeholder> Positions::serializePlaceholders() const
+{
+    LayoutSaver::Placeholder::List placeholders;
+    placeholders.reserve(int(m_placeholders.size()));
 
     for (auto &itemRef : m_placeholders) {
         LayoutSaver::Placeholder p;
 
         Core::Item *item = itemRef->item;
         Core::Layout *layout = DockRegistry::self()->layoutForItem(item);
-        const auto itemIndex = layout->items().indexOf(item);
+        int itemIndex = -1;
+        int index = 0;
+        layout->rootItem()->visit_recursive([&index, &itemIndex, item](Core::Item *candidate) {
+            if (candidate == item) {
+                itemIndex = index;
+                return false;
+            }
+            ++index;
+            return true;
+        });
 
         auto fw = layout->floatingWindow();
         auto mainWindow = layout->mainWindow(/*honourNesting=*/true);
@@ -249,16 +323,35 @@ LayoutSaver::Position Positions::serialize() const
         }
 
         p.itemIndex = itemIndex;
-        l.placeholders.push_back(p);
+        placeholders.push_back(p);
     }
 
-    l.tabIndex = m_tabIndex;
-    l.wasFloating = m_wasFloating;
+    return placeholders;
+}
 
-    l.lastFloatingGeometry = lastFloatingGeometry();
-    l.lastOverlayedGeometries = m_lastOverlayedGeometries;
+std::vector<uint64_t> Positions::placeholdersSerializationKey(const Vector<Core::FloatingWindow *> &floatingWindows) const
+{
+    // serializePlaceholders() depends on our list, on the index of each item within its layout
+    // and on the index of floating windows. The first two are covered by the generations, the
+    // latter is cheap to query.
+    std::vector<uint64_t> key;
+    key.reserve(1 + 2 * m_placeholders.size());
+    key.push_back(m_generation);
 
-    return l;
+    for (auto &itemRef : m_placeholders) {
+        Core::Item *item = itemRef->item;
+        Core::LayoutingHost *host = item->host();
+        key.push_back(host ? host->generation() : 0);
+
+        Core::Layout *layout = DockRegistry::self()->layoutForItem(item);
+        auto fw = layout ? layout->floatingWindow() : nullptr;
+        if (fw && !fw->beingDeleted())
+            key.push_back(uint64_t(floatingWindows.indexOf(fw) + 1));
+        else
+            key.push_back(0);
+    }
+
+    return key;
 }
 
 Positions::ItemRef::ItemRef(KDBindings::ConnectionHandle conn, Core::Item *it)
@@ -24,14 +24,17 @@
 
 #include <kdbindings/signal.h>
 
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace KDDockWidgets {
 
 namespace Core {
 class Item;
 class DockWidget;
+class FloatingWindow;
 class Group;
 class Layout;
 class LayoutingHost;
@@ -54,12 +57,24 @@ class DOCKS_EXPORT_FOR_UNIT_TESTS Positions
     KDDW_DELETE_COPY_CTOR(Positions)
 public:
     typedef std::shared_ptr<Positions> Ptr;
-    Positions() = default;
+    Positions();
     ~Positions();
 
     void deserialize(const LayoutSaver::Position &);
     LayoutSaver::Position serialize() const;
 
+    /// Same as serialize() but leaves the placeholders empty, for callers which have them cached
+    LayoutSaver::Position serializeWithoutPlaceholders() const;
+
+    /// The placeholder part of serialize(), which is the expensive one
+    Vector<LayoutSaver::Placeholder> serializePlaceholders() const;
+
+    /// Returns a key which only changes when serializePlaceholders() would return something else.
+    /// Cheap to compute, allows LayoutSaver to reuse a previous result.
+    /// @p floatingWindows is DockRegistry::floatingWindows(), so callers computing many keys only
+    /// query it once.
+    std::vector<uint64_t> placeholdersSerializationKey(const Vector<Core::FloatingWindow *> &floatingWindows) const;
+
     ///@brief The tab index in case the dock widget was in a TabWidget, -1 otherwise.
     int m_tabIndex = -1;
 
@@ -93,6 +108,13 @@ public:
     /// We don't support memorizing more than 1 main window or more than 1 floating window
     int placeholderCount() const;
 
+    /// Returns the placeholder Items, in the same order as they were added.
+    /// nullptr for references whose Item was already destroyed.
+    Vector<Core::Item *> placeholderItems() const;
+
+    /// The approximate bytes each placeholder reference costs, for Core::MemoryReport
+    static size_t placeholderRefSize();
+
     void saveTabIndex(int tabIndex, bool isFloating)
     {
         m_tabIndex = tabIndex;
@@ -155,6 +177,7 @@ private:
     };
 
     bool itemIsBeingDestroyed(Core::Item *) const;
+    void markPlaceholdersChanged();
 
     // The last places where this dock widget was (or is), so it can be restored when
     // setFloating(false) or show() is called.
@@ -162,6 +185,7 @@ private:
     Rect m_lastFloatingGeometry;
     std::unordered_map<SideBarLocation, Rect> m_lastOverlayedGeometries;
     bool m_clearing = false; // to prevent re-entrancy
+    uint64_t m_generation;
 };
 
 }
@@ -0,0 +1,206 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "Profiler_p.h"
+#include "Logging_p.h"
+#include "nlohmann_helpers_p.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Core;
+
+bool Profiler::Private::s_enabled = false;
+
+namespace {
+
+struct Stats
+{
+    int64_t count = 0;
+    int64_t totalNanoseconds = 0;
+    int64_t maxNanoseconds = 0;
+};
+
+struct TraceEvent
+{
+    const char *name = nullptr;
+    int64_t startNanoseconds = 0;
+    int64_t durationNanoseconds = 0;
+};
+
+struct Storage
+{
+    // Keyed by content, as the same literal might have a different address in each translation unit
+    std::unordered_map<std::string_view, Stats> stats;
+    std::vector<TraceEvent> events;
+    int64_t numDroppedEvents = 0;
+    int maxEvents = 1000000;
+    Profiler::Private::Clock::time_point epoch = Profiler::Private::Clock::now();
+};
+
+Storage &storage()
+{
+    static Storage s;
+    return s;
+}
+
+int64_t nanoseconds(Profiler::Private::Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+void addTraceEvent(Storage &s, const TraceEvent &ev)
+{
+    if (int(s.events.size()) < s.maxEvents) {
+        s.events.push_back(ev);
+    } else {
+        ++s.numDroppedEvents;
+    }
+}
+
+}
+
+void Profiler::Private::recordScope(const char *name, Clock::time_point start, Clock::time_point end)
+{
+    if (!s_enabled)
+        return;
+
+    Storage &s = storage();
+    const int64_t duration = nanoseconds(end - start);
+
+    Stats &stats = s.stats[name];
+    ++stats.count;
+    stats.totalNanoseconds += duration;
+    stats.maxNanoseconds = std::max(stats.maxNanoseconds, duration);
+
+    addTraceEvent(s, { name, nanoseconds(start - s.epoch), duration });
+}
+
+bool Profiler::isAvailable()
+{
+#ifdef KDDW_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !isAvailable()) {
+        KDDW_ERROR("Profiler::setEnabled: KDDW was built without -DKDDockWidgets_PROFILING=ON");
+        return;
+    }
+
+    if (enabled && !Private::s_enabled && storage().events.empty())
+        storage().epoch = Private::Clock::now();
+
+    Private::s_enabled = enabled;
+}
+
+bool Profiler::isEnabled()
+{
+    return Private::s_enabled;
+}
+
+void Profiler::reset()
+{
+    Storage &s = storage();
+    s.stats.clear();
+    s.events.clear();
+    s.numDroppedEvents = 0;
+    s.epoch = Private::Clock::now();
+}
+
+Vector<Profiler::Counter> Profiler::counters()
+{
+    const Storage &s = storage();
+
+    Vector<Counter> result;
+    result.reserve(int(s.stats.size()));
+    for (const auto &it : s.stats) {
+        Counter counter;
+        counter.name = QString::fromUtf8(std::string(it.first).c_str());
+        counter.count = it.second.count;
+        counter.totalNanoseconds = it.second.totalNanoseconds;
+        counter.maxNanoseconds = it.second.maxNanoseconds;
+        result.push_back(counter);
+    }
+
+    std::sort(result.begin(), result.end(), [](const Counter &c1, const Counter &c2) {
+        if (c1.totalNanoseconds != c2.totalNanoseconds)
+            return c1.totalNanoseconds > c2.totalNanoseconds;
+        return c1.count > c2.count;
+    });
+
+    return result;
+}
+
+QByteArray Profiler::chromeTrace()
+{
+    const Storage &s = storage();
+
+    nlohmann::json events = nlohmann::json::array();
+    for (const TraceEvent &ev : s.events) {
+        nlohmann::json event;
+        event["name"] = ev.name;
+        event["cat"] = "kddw";
+        event["pid"] = 0;
+        event["tid"] = 0;
+        // Trace-event timestamps are in microseconds
+        event["ts"] = double(ev.startNanoseconds) / 1000.0;
+        event["ph"] = "X";
+        event["dur"] = double(ev.durationNanoseconds) / 1000.0;
+
+        events.push_back(std::move(event));
+    }
+
+    nlohmann::json json;
+    json["traceEvents"] = std::move(events);
+    json["displayTimeUnit"] = "ns";
+    json["otherData"]["droppedEvents"] = s.numDroppedEvents;
+
+    return QByteArray::fromStdString(json.dump());
+}
+
+bool Profiler::saveChromeTrace(const QString &filename)
+{
+    const QByteArray data = chromeTrace();
+
+    std::ofstream file(filename.toStdString(), std::ios::binary);
+    if (!file.is_open()) {
+        KDDW_ERROR("Failed to open {}", filename);
+        return false;
+    }
+
+    file.write(data.constData(), data.size());
+    file.close();
+    return true;
+}
+
+void Profiler::setMaxTraceEvents(int max)
+{
+    Storage &s = storage();
+    s.maxEvents = std::max(0, max);
+    if (int(s.events.size()) > s.maxEvents) {
+        s.numDroppedEvents += int64_t(s.events.size()) - s.maxEvents;
+        s.events.resize(size_t(s.maxEvents));
+    }
+}
+
+int Profiler::maxTraceEvents()
+{
+    return storage().maxEvents;
+}
@@ -0,0 +1,88 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/**
+ * @file
+ * @brief Opt-in instrumentation of the layouting engine, layout restore and drag & drop
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#ifndef KD_DOCKWIDGETS_PROFILER_H
+#define KD_DOCKWIDGETS_PROFILER_H
+
+#include "kddockwidgets/docks_export.h"
+#include "kddockwidgets/KDDockWidgets.h"
+#include "kddockwidgets/QtCompat_p.h"
+
+#include <cstdint>
+
+namespace KDDockWidgets::Core {
+
+/// @brief Collects timings and counters for the expensive parts of KDDW
+///
+/// Instrumented are the ItemBoxContainer layouting passes (growItem, shrinkNeighbours,
+/// calculateSqueezes, honourMaxSizes, updateSeparators and simplify), the phases of
+/// LayoutSaver::restoreLayout() and the DragController state transitions.
+///
+/// Only available when KDDW is built with -DKDDockWidgets_PROFILING=ON, otherwise the
+/// instrumentation compiles to nothing, isAvailable() returns false and there's nothing to read.
+/// Even when available, nothing is recorded until setEnabled(true) is called.
+///
+/// Not thread-safe, it's meant to be used from the GUI thread, same as the rest of KDDW.
+class DOCKS_EXPORT Profiler
+{
+public:
+    /// @brief Aggregated statistics for a single instrumented operation
+    struct Counter
+    {
+        /// The name of the operation, for example "ItemBoxContainer::growItem"
+        QString name;
+        /// How many times the operation ran
+        int64_t count = 0;
+        /// Sum of the durations, in nanoseconds. 0 for operations which are only counted.
+        int64_t totalNanoseconds = 0;
+        /// The longest single run, in nanoseconds
+        int64_t maxNanoseconds = 0;
+    };
+
+    /// @brief Returns whether KDDW was built with profiling support
+    static bool isAvailable();
+
+    /// @brief Starts or stops recording. Does nothing if isAvailable() is false.
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /// @brief Discards everything that was recorded so far
+    static void reset();
+
+    /// @brief Returns the statistics for every operation recorded since the last reset()
+    /// Sorted by total time, most expensive first.
+    static Vector<Counter> counters();
+
+    /// @brief Returns the recorded events in Chrome's trace-event JSON format
+    /// Can be loaded into chrome://tracing or https://ui.perfetto.dev
+    /// Only the first maxTraceEvents() events are kept, counters() still sees everything.
+    static QByteArray chromeTrace();
+
+    /// @brief Writes chromeTrace() into @p filename. Returns false on error.
+    static bool saveChromeTrace(const QString &filename);
+
+    /// @brief Sets how many trace events are kept in memory. The default is 1000000.
+    static void setMaxTraceEvents(int);
+    static int maxTraceEvents();
+
+    class Private;
+};
+
+}
+
+#endif
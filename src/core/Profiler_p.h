@@ -0,0 +1,122 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include "kddockwidgets/core/Profiler.h"
+
+#include <chrono>
+
+/// Instrumentation macros, see Core::Profiler.
+/// Without -DKDDockWidgets_PROFILING=ON they expand to nothing.
+/// Names must be string literals, they're stored by pointer.
+
+#ifdef KDDW_PROFILING
+
+#define KDDW_PROFILE_CONCAT_IMPL(a, b) a##b
+#define KDDW_PROFILE_CONCAT(a, b) KDDW_PROFILE_CONCAT_IMPL(a, b)
+
+/// Times the rest of the enclosing scope
+#define KDDW_PROFILE_SCOPE(name) \
+    KDDockWidgets::Core::ProfilerScope KDDW_PROFILE_CONCAT(kddwProfilerScope, __LINE__)(name)
+
+/// Declares a timer for consecutive phases of the enclosing scope, see KDDW_PROFILE_PHASE()
+#define KDDW_PROFILE_PHASES(phases) KDDockWidgets::Core::ProfilerPhases phases
+
+/// Ends the current phase, if any, and starts timing the next one.
+/// The last phase ends with the scope.
+#define KDDW_PROFILE_PHASE(phases, name) phases.begin(name)
+
+#else
+
+#define KDDW_PROFILE_SCOPE(name) (( void )0)
+#define KDDW_PROFILE_PHASES(phases) (( void )0)
+#define KDDW_PROFILE_PHASE(phases, name) (( void )0)
+
+#endif
+
+namespace KDDockWidgets {
+
+namespace Core {
+
+class Profiler::Private
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static void recordScope(const char *name, Clock::time_point start, Clock::time_point end);
+
+    /// Checked inline by ProfilerScope, so a disabled profiler doesn't even read the clock
+    static bool s_enabled;
+};
+
+/// @internal
+/// RAII timer behind KDDW_PROFILE_SCOPE()
+class ProfilerScope
+{
+    KDDW_DELETE_COPY_CTOR(ProfilerScope)
+public:
+    explicit ProfilerScope(const char *name)
+        : m_name(Profiler::Private::s_enabled ? name : nullptr)
+    {
+        if (m_name)
+            m_start = Profiler::Private::Clock::now();
+    }
+
+    ~ProfilerScope()
+    {
+        if (m_name)
+            Profiler::Private::recordScope(m_name, m_start, Profiler::Private::Clock::now());
+    }
+
+private:
+    const char *const m_name;
+    Profiler::Private::Clock::time_point m_start;
+};
+
+/// @internal
+/// Timer behind KDDW_PROFILE_PHASES()
+class ProfilerPhases
+{
+    KDDW_DELETE_COPY_CTOR(ProfilerPhases)
+public:
+    ProfilerPhases() = default;
+
+    ~ProfilerPhases()
+    {
+        end();
+    }
+
+    void begin(const char *name)
+    {
+        end();
+        if (Profiler::Private::s_enabled) {
+            m_name = name;
+            m_start = Profiler::Private::Clock::now();
+        }
+    }
+
+private:
+    void end()
+    {
+        if (m_name) {
+            Profiler::Private::recordScope(m_name, m_start, Profiler::Private::Clock::now());
+            m_name = nullptr;
+        }
+    }
+
+    const char *m_name = nullptr;
+    Profiler::Private::Clock::time_point m_start;
+};
+
+}
+
+}
@@ -10,7 +10,35 @@
 */
 
 #include "Screen_p.h"
+#include "View.h"
+#include "Window_p.h"
+
+#include <algorithm>
+#include <cmath>
 
 using namespace KDDockWidgets::Core;
 
+static const double s_defaultRefreshRate = 60;
+
 Screen::~Screen() = default;
+
+double Screen::refreshRate() const
+{
+    return s_defaultRefreshRate;
+}
+
+/** static */
+int Screen::frameIntervalFor(View *view)
+{
+    double rate = s_defaultRefreshRate;
+    if (auto window = view ? view->window() : nullptr) {
+        if (Screen::Ptr screen = window->screen())
+            rate = screen->refreshRate();
+    }
+
+    // Some platforms report 0 when they don't know
+    if (rate <= 0)
+        rate = s_defaultRefreshRate;
+
+    return std::max(1, int(std::lround(1000.0 / rate)));
+}
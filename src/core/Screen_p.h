@@ -18,6 +18,8 @@
 
 namespace KDDockWidgets::Core {
 
+class View;
+
 /// @brief Represents a Screen
 /// In Qt for example, this would be equivalent to QScreen.
 class DOCKS_EXPORT Screen
@@ -59,6 +61,14 @@ public:
     /// @brief Returns whether the two Screen instances refer to the same underlying platform Screen
     virtual bool equals(std::shared_ptr<Screen> other) const = 0;
 
+    /// @brief returns how many times per second the screen is refreshed
+    /// The default implementation returns 60, for frontends which can't tell.
+    virtual double refreshRate() const;
+
+    /// @brief returns the time between two refreshes of the screen @p view is on, in milliseconds
+    /// At least 1. Assumes 60Hz if the view isn't on a screen yet.
+    static int frameIntervalFor(View *view);
+
     bool operator==(Screen *) = delete;
     bool operator!=(Screen *) = delete;
 
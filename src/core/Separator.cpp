@@ -19,6 +19,8 @@
 #include "Platform.h"
 #include "Controller.h"
 #include "core/ViewFactory.h"
+#include "core/DelayedCall_p.h"
+#include "Screen_p.h"
 
 
 #ifdef Q_OS_WIN
@@ -81,9 +83,36 @@ struct Separator::Private : public LayoutingSeparator
         q->view()->raise();
     }
 
+    void onRecycled() override
+    {
+        // Not counted while unused, numSeparators() is about what's in the layout
+        s_numSeparators--;
+        m_isRecycled = true;
+        q->setVisible(false);
+
+        // So the next setGeometry() isn't a no-op and shows the separator again
+        m_geometry = {};
+
+        // A move still queued for the previous container mustn't be applied in the next one
+        pendingMovePosition = -1;
+        moveScheduled = false;
+    }
+
+    void onReused() override
+    {
+        s_numSeparators++;
+        m_isRecycled = false;
+    }
+
     Core::Separator *const q;
     Rect m_geometry;
+    bool m_isRecycled = false;
     int lazyPosition = 0;
+
+    /// Where the mouse last moved to, while moves are being coalesced. -1 if nothing pending.
+    int pendingMovePosition = -1;
+    bool moveScheduled = false;
+
     View *lazyResizeRubberBand = nullptr;
     const bool usesLazyResize = Config::self().flags() & Config::Flag_LazyResize;
 };
@@ -182,6 +211,8 @@ void Separator::onMousePress()
 
 void Separator::onMouseReleased()
 {
+    applyPendingMove();
+
     if (d->lazyResizeRubberBand) {
         d->lazyResizeRubberBand->hide();
         d->m_parentContainer->requestSeparatorMove(d, d->lazyPosition - position());
@@ -229,11 +260,37 @@ void Separator::onMouseMove(Point pos)
         const int positionToGoTo = d->onMouseMove(pos, /*moveSeparator=*/false);
         if (positionToGoTo != -1)
             setLazyPosition(positionToGoTo);
+    } else if (const int interval = Config::self().separatorMoveInterval(); interval >= 0) {
+        // Only remember where to go, the layout is updated once per interval
+        const int positionToGoTo = d->onMouseMove(pos, /*moveSeparator=*/false);
+        if (positionToGoTo == -1)
+            return;
+
+        d->pendingMovePosition = positionToGoTo;
+        if (!d->moveScheduled) {
+            d->moveScheduled = true;
+            // 0 paces moves to the screen's refresh rate
+            const int delay = interval == 0 ? Screen::frameIntervalFor(view()) : interval;
+            Platform::instance()->runDelayed(delay, new DelayedSeparatorMove(this));
+        }
     } else {
         d->onMouseMove(pos, /*moveSeparator=*/true);
     }
 }
 
+void Separator::applyPendingMove()
+{
+    d->moveScheduled = false;
+
+    const int position = d->pendingMovePosition;
+    if (position == -1)
+        return;
+
+    d->pendingMovePosition = -1;
+    if (d->m_parentContainer && position != this->position())
+        d->m_parentContainer->requestSeparatorMove(d, position - this->position());
+}
+
 LayoutingSeparator *Separator::asLayoutingSeparator() const
 {
     return d;
@@ -253,5 +310,6 @@ int Separator::numSeparators()
 
 Separator::Private::~Private()
 {
-    s_numSeparators--;
+    if (!m_isRecycled)
+        s_numSeparators--;
 }
@@ -57,11 +57,15 @@ public:
 
 private:
     friend class KDDockWidgets::Config;
+    friend class DelayedSeparatorMove;
 
     KDDW_DELETE_COPY_CTOR(Separator)
     void setLazyPosition(int);
     bool usesLazyResize() const;
 
+    /// Applies the position the mouse last moved to, if any, see Config::setSeparatorMoveInterval()
+    void applyPendingMove();
+
     struct Private;
     Private *const d;
 };
@@ -0,0 +1,160 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include "kddockwidgets/KDDockWidgets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace KDDockWidgets {
+
+namespace Core {
+
+/// @internal
+/// A uniform grid of rects, answering "which rect contains this point" without visiting them all.
+/// Meant for layouts, where rects don't overlap, so each cell only references a couple of them.
+/// Overlapping rects, like MDI windows, work too, the order passed to build() decides which one wins.
+/// Rebuild it when the rects change, there's no incremental update.
+template<typename T>
+class SpatialIndex
+{
+public:
+    void clear()
+    {
+        m_entries.clear();
+        m_cells.clear();
+        m_bounds = {};
+        m_numColumns = 0;
+        m_numRows = 0;
+    }
+
+    bool isEmpty() const
+    {
+        return m_entries.empty();
+    }
+
+    /// Sets the rects to index. On overlap, the first one in @p entries wins.
+    void build(std::vector<std::pair<Rect, T>> entries)
+    {
+        clear();
+        m_entries = std::move(entries);
+        m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                       [](const auto &entry) { return entry.first.isEmpty(); }),
+                        m_entries.end());
+        if (m_entries.empty())
+            return;
+
+        int left = m_entries.front().first.left();
+        int top = m_entries.front().first.top();
+        int right = m_entries.front().first.right();
+        int bottom = m_entries.front().first.bottom();
+        for (const auto &entry : m_entries) {
+            left = std::min(left, entry.first.left());
+            top = std::min(top, entry.first.top());
+            right = std::max(right, entry.first.right());
+            bottom = std::max(bottom, entry.first.bottom());
+        }
+
+        m_bounds = Rect(Point(left, top), Size(right - left + 1, bottom - top + 1));
+
+        // About one rect per cell
+        const int dimension = std::max(1, int(std::ceil(std::sqrt(double(m_entries.size())))));
+        m_numColumns = std::min(dimension, m_bounds.width());
+        m_numRows = std::min(dimension, m_bounds.height());
+        m_cells.resize(size_t(m_numColumns) * size_t(m_numRows));
+
+        for (int i = 0; i < int(m_entries.size()); ++i) {
+            const Rect r = m_entries[size_t(i)].first;
+            const int firstColumn = columnAt(r.left());
+            const int lastColumn = columnAt(r.right());
+            const int firstRow = rowAt(r.top());
+            const int lastRow = rowAt(r.bottom());
+            for (int row = firstRow; row <= lastRow; ++row) {
+                for (int column = firstColumn; column <= lastColumn; ++column)
+                    m_cells[cellIndex(column, row)].push_back(i);
+            }
+        }
+    }
+
+    /// Returns the value of the rect containing @p pt, or @p defaultValue if there's none
+    T valueAt(Point pt, T defaultValue = {}) const
+    {
+        if (!m_bounds.contains(pt))
+            return defaultValue;
+
+        for (int i : m_cells[cellIndex(columnAt(pt.x()), rowAt(pt.y()))]) {
+            const auto &entry = m_entries[size_t(i)];
+            if (entry.first.contains(pt))
+                return entry.second;
+        }
+
+        return defaultValue;
+    }
+
+    /// Calls @p visitor with the value of each rect intersecting @p rect, once per rect,
+    /// in the order they were passed to build()
+    template<typename Visitor>
+    void visitIntersecting(Rect rect, Visitor &&visitor) const
+    {
+        rect = rect.intersected(m_bounds);
+        if (rect.isEmpty())
+            return;
+
+        std::vector<int> candidates;
+        for (int row = rowAt(rect.top()); row <= rowAt(rect.bottom()); ++row) {
+            for (int column = columnAt(rect.left()); column <= columnAt(rect.right()); ++column) {
+                const std::vector<int> &cell = m_cells[cellIndex(column, row)];
+                candidates.insert(candidates.end(), cell.cbegin(), cell.cend());
+            }
+        }
+
+        // A rect spanning several cells is referenced by each of them
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        for (int i : candidates) {
+            const auto &entry = m_entries[size_t(i)];
+            if (entry.first.intersects(rect))
+                visitor(entry.second);
+        }
+    }
+
+private:
+    int columnAt(int x) const
+    {
+        return std::clamp(int((int64_t(x - m_bounds.x()) * m_numColumns) / m_bounds.width()), 0, m_numColumns - 1);
+    }
+
+    int rowAt(int y) const
+    {
+        return std::clamp(int((int64_t(y - m_bounds.y()) * m_numRows) / m_bounds.height()), 0, m_numRows - 1);
+    }
+
+    size_t cellIndex(int column, int row) const
+    {
+        return size_t(row) * size_t(m_numColumns) + size_t(column);
+    }
+
+    std::vector<std::pair<Rect, T>> m_entries;
+    std::vector<std::vector<int>> m_cells;
+    Rect m_bounds;
+    int m_numColumns = 0;
+    int m_numRows = 0;
+};
+
+}
+
+}
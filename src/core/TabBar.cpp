@@ -333,6 +333,10 @@ void TabBar::setCurrentIndex(int index)
         d->m_currentDockWidget->d->isCurrentTabChanged.emit(false);
     }
 
+    // While restoring each tab is briefly made current, LayoutSaver does it for the final ones
+    if (newCurrentDw && !LayoutSaver::restoreInProgress())
+        newCurrentDw->ensureGuestView();
+
     d->m_currentDockWidget = newCurrentDw;
     d->currentDockWidgetChanged.emit(newCurrentDw);
     if (auto tvi = dynamic_cast<Core::TabBarViewInterface *>(view()))
@@ -16,6 +16,8 @@
 #include "View_p.h"
 #include "Logging_p.h"
 #include "DockRegistry_p.h"
+#include "DelayedCall_p.h"
+#include "Screen_p.h"
 #include "QtCompat_p.h"
 
 #include "kddockwidgets/core/DockRegistry.h"
@@ -23,6 +25,7 @@
 #include "kddockwidgets/core/TitleBar.h"
 #include "kddockwidgets/core/FloatingWindow.h"
 #include "kddockwidgets/core/Platform.h"
+#include "kddockwidgets/core/ViewFactory.h"
 #include "core/ScopedValueRollback_p.h"
 
 #include <cstdlib>
@@ -77,6 +80,9 @@ WidgetResizeHandler::~WidgetResizeHandler()
     }
 
     restoreMouseCursor();
+
+    if (m_rubberBand)
+        m_rubberBand.view()->d->free();
 }
 
 void WidgetResizeHandler::setAllowedResizeSides(CursorPositions sides)
@@ -190,10 +196,28 @@ bool WidgetResizeHandler::onMouseEvent(View *widget, MouseEvent *e)
         mNewPosition = Qt5Qt6Compat::eventGlobalPos(e);
         mCursorPos = cursorPos;
 
+        m_lazyResizeInProgress = Config::self().lazyWindowResize() && supportsLazyResize();
+        if (m_lazyResizeInProgress) {
+            if (!m_rubberBand) {
+                // Floating windows get a top-level one, MDI ones live in the MDI area
+                auto group = mTarget->asGroupController();
+                MDILayout *mdiLayout = m_isTopLevelWindowResizer || !group ? nullptr : group->mdiLayout();
+                View *parent = mdiLayout ? mdiLayout->view() : nullptr;
+                m_rubberBand = Config::self().viewFactory()->createRubberBand(parent);
+                if (!parent)
+                    m_rubberBand->setWindowOpacity(0.5);
+            }
+
+            m_rubberBand->setGeometry(mTarget->geometry());
+            m_rubberBand->show();
+            m_rubberBand->raise();
+        }
+
         return true;
     }
     case Event::MouseButtonRelease: {
         m_resizingInProgress = false;
+        applyPendingResize();
         if (isMDI()) {
             DockRegistry::self()->dptr()->groupInMDIResizeChanged.emit();
             // Usually in KDDW all geometry changes are done in the layout items, which propagate to
@@ -245,6 +269,9 @@ bool WidgetResizeHandler::mouseMoveEvent(MouseEvent *e)
 {
     const Point globalPos = Qt5Qt6Compat::eventGlobalPos(e);
     if (!m_resizingInProgress) {
+        // In case the release was eaten by someone else
+        applyPendingResize();
+
         const CursorPosition pos = cursorPosition(globalPos);
         updateCursor(pos);
         return pos != CursorPosition_Undefined;
@@ -334,7 +361,7 @@ bool WidgetResizeHandler::mouseMoveEvent(MouseEvent *e)
         }
     }
 
-    if (newGeometry == mTarget->geometry()) {
+    if (newGeometry == mTarget->geometry() && m_pendingGeometry.isNull()) {
         // Nothing to do.
         return true;
     }
@@ -348,10 +375,64 @@ bool WidgetResizeHandler::mouseMoveEvent(MouseEvent *e)
         newGeometry.moveTopLeft(mTarget->mapFromGlobal(newGeometry.topLeft()) + mTarget->pos());
     }
 
-    mTarget->setGeometry(newGeometry);
+    resizeTarget(newGeometry);
     return true;
 }
 
+void WidgetResizeHandler::resizeTarget(Rect geometry)
+{
+    if (m_lazyResizeInProgress) {
+        m_pendingGeometry = geometry;
+        if (m_rubberBand)
+            m_rubberBand->setGeometry(geometry);
+        return;
+    }
+
+    const int interval = Config::self().windowResizeInterval();
+    if (interval < 0) {
+        mTarget->setGeometry(geometry);
+        return;
+    }
+
+    // Only remember where to go, the window is resized once per interval
+    m_pendingGeometry = geometry;
+    if (!m_resizeScheduled) {
+        m_resizeScheduled = true;
+        // 0 paces resizes to the screen's refresh rate
+        const int delay = interval == 0 ? Screen::frameIntervalFor(mTarget) : interval;
+        Platform::instance()->runDelayed(delay, new Core::DelayedWindowResize(this));
+    }
+}
+
+void WidgetResizeHandler::applyPendingResize()
+{
+    m_resizeScheduled = false;
+
+    if (m_lazyResizeInProgress) {
+        // Lazy resizes are only applied once the mouse is released
+        if (m_resizingInProgress)
+            return;
+
+        m_lazyResizeInProgress = false;
+        if (m_rubberBand)
+            m_rubberBand->hide();
+    }
+
+    if (m_pendingGeometry.isNull())
+        return;
+
+    const Rect geometry = m_pendingGeometry;
+    m_pendingGeometry = {};
+    if (mTargetGuard && geometry != mTarget->geometry())
+        mTarget->setGeometry(geometry);
+}
+
+bool WidgetResizeHandler::supportsLazyResize() const
+{
+    // A top-level rubber band is only supported by QtWidgets
+    return !m_isTopLevelWindowResizer || Platform::instance()->isQtWidgets();
+}
+
 #ifdef KDDW_FRONTEND_QT_WINDOWS
 
 void WidgetResizeHandler::requestNCCALCSIZE(HWND winId)
@@ -30,6 +30,7 @@ namespace KDDockWidgets {
 
 namespace Core {
 class FloatingWindow;
+class DelayedWindowResize;
 }
 
 class DOCKS_EXPORT WidgetResizeHandler : public Core::Object, public Core::EventFilterInterface
@@ -173,6 +174,14 @@ private:
     void setMouseCursor(Qt::CursorShape);
     void restoreMouseCursor();
 
+    /// Resizes mTarget, or just remembers the geometry if the resize is lazy or being coalesced
+    /// See Config::setWindowResizeInterval() and Config::setLazyWindowResize()
+    void resizeTarget(Rect);
+    /// Applies the geometry remembered by resizeTarget(), if any
+    void applyPendingResize();
+    bool supportsLazyResize() const;
+    friend class Core::DelayedWindowResize;
+
     /// Returns which widget side the cursor is at for resize purposes
     /// Honours fixed size widgets. If fixed size, no position will be reported.
     CursorPosition cursorPosition(Point) const;
@@ -193,6 +202,13 @@ private:
     bool m_handlesMouseCursor = true;
 
     bool m_eventFilteringStartsManually = false;
+
+    /// The geometry the mouse last asked for, while it's not applied yet. Null if nothing pending.
+    Rect m_pendingGeometry;
+    bool m_resizeScheduled = false;
+    /// Whether the resize in progress only moves m_rubberBand, decided on mouse press
+    bool m_lazyResizeInProgress = false;
+    Core::ViewGuard m_rubberBand = nullptr;
 };
 
 #if defined(Q_OS_WIN) && defined(KDDW_FRONTEND_QTWIDGETS)
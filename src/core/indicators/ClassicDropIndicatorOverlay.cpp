@@ -69,6 +69,9 @@ bool ClassicDropIndicatorOverlay::onResize(Size)
 
 void ClassicDropIndicatorOverlay::updateVisibility()
 {
+    // A new drag, or a different group, recompute the rubber band on the next hover
+    m_rubberBandKey = {};
+
     if (isHovered()) {
         m_indicatorWindow->updatePositions();
         m_indicatorWindow->setVisible(true);
@@ -120,6 +123,11 @@ void ClassicDropIndicatorOverlay::setCurrentDropLocation(DropLocation location)
 {
     DropIndicatorOverlay::setCurrentDropLocation(location);
 
+    const RubberBandKey key = { location, m_hoveredGroup, layoutGeneration() };
+    if (key == m_rubberBandKey)
+        return;
+    m_rubberBandKey = key;
+
     if (location == DropLocation_None) {
         m_rubberBand->setVisible(false);
         return;
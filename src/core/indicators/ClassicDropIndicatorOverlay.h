@@ -46,6 +46,21 @@ private:
 
     View *const m_rubberBand;
     Core::ClassicIndicatorWindowViewInterface *const m_indicatorWindow;
+
+    /// What the rubber band's geometry was last computed for. rectForDrop() is expensive and
+    /// the result doesn't change while the mouse moves within the same indicator.
+    struct RubberBandKey
+    {
+        DropLocation location = DropLocation_None;
+        Group *group = nullptr;
+        uint64_t layoutGeneration = 0;
+
+        bool operator==(const RubberBandKey &other) const
+        {
+            return location == other.location && group == other.group && layoutGeneration == other.layoutGeneration;
+        }
+    };
+    RubberBandKey m_rubberBandKey;
 };
 
 }
@@ -43,12 +43,40 @@ SegmentedDropIndicatorOverlay::~SegmentedDropIndicatorOverlay() = default;
 DropLocation SegmentedDropIndicatorOverlay::hover_impl(Point pt)
 {
     m_hoveredPt = view()->mapFromGlobal(pt);
-    updateSegments();
-    setCurrentDropLocation(dropLocationForPos(m_hoveredPt));
+    const DropLocation oldLocation = currentDropLocation();
+
+    if (segmentsAreCurrent()) {
+        // Common case, the mouse moved a bit but is still over the same segment
+        auto it = m_segments.find(oldLocation);
+        if (it != m_segments.cend() && it->second.containsPoint(m_hoveredPt, Qt::OddEvenFill))
+            return oldLocation;
+
+        setCurrentDropLocation(dropLocationForPos(m_hoveredPt));
+
+        // Only the highlighted segment changes
+        if (currentDropLocation() != oldLocation)
+            view()->update();
+    } else {
+        updateSegments();
+        setCurrentDropLocation(dropLocationForPos(m_hoveredPt));
+    }
 
     return currentDropLocation();
 }
 
+bool SegmentedDropIndicatorOverlay::segmentsAreCurrent() const
+{
+    return m_segmentsKey == SegmentsKey { rect(), hoveredGroupRect(), m_hoveredGroup, layoutGeneration() };
+}
+
+void SegmentedDropIndicatorOverlay::updateVisibility()
+{
+    DropIndicatorOverlay::updateVisibility();
+
+    // Which segments are visible depends on the hovered group and the window being dragged
+    m_segmentsKey = {};
+}
+
 DropLocation SegmentedDropIndicatorOverlay::dropLocationForPos(Point pos) const
 {
     for (const auto &m_segment : m_segments) {
@@ -130,6 +158,7 @@ std::unordered_map<DropLocation, Polygon> SegmentedDropIndicatorOverlay::segment
 void SegmentedDropIndicatorOverlay::updateSegments()
 {
     m_segments.clear();
+    m_segmentsKey = { rect(), hoveredGroupRect(), m_hoveredGroup, layoutGeneration() };
 
     const auto outterSegments = segmentsForRect(rect(), /*inner=*/false);
 
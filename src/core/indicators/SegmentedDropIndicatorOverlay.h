@@ -40,12 +40,30 @@ public:
 
 protected:
     Point posForIndicator(DropLocation) const override;
+    void updateVisibility() override;
 
 private:
     std::unordered_map<DropLocation, Polygon> segmentsForRect(Rect, bool inner, bool useOffset = false) const;
     void updateSegments();
+    bool segmentsAreCurrent() const;
     Point m_hoveredPt = {};
     std::unordered_map<DropLocation, Polygon> m_segments;
+
+    /// What m_segments was built for, so small mouse moves don't rebuild them
+    struct SegmentsKey
+    {
+        Rect rect;
+        Rect hoveredGroupRect;
+        Group *group = nullptr;
+        uint64_t layoutGeneration = 0;
+
+        bool operator==(const SegmentsKey &other) const
+        {
+            return rect == other.rect && hoveredGroupRect == other.hoveredGroupRect && group == other.group
+                && layoutGeneration == other.layoutGeneration;
+        }
+    };
+    SegmentsKey m_segmentsKey;
 };
 
 }
@@ -17,6 +17,7 @@
 
 #include "core/Logging_p.h"
 #include "core/ObjectGuard_p.h"
+#include "core/Profiler_p.h"
 #include "core/ScopedValueRollback_p.h"
 #include "core/Utils_p.h"
 #include "core/nlohmann_helpers_p.h"
@@ -24,6 +25,7 @@
 #include <algorithm>
 #include <iostream>
 #include <cstdlib>
+#include <optional>
 #include <utility>
 
 #ifdef KDDW_FRONTEND_QT
@@ -50,6 +52,7 @@ using namespace KDDockWidgets::Core;
 
 int Core::Item::separatorThickness = 5;
 int Core::Item::layoutSpacing = 5;
+int Core::Item::maxRecycledSeparators = 16;
 bool Core::Item::s_silenceSanityChecks = false;
 
 DumpScreenInfoFunc Core::Item::s_dumpScreenInfoFunc = nullptr;
@@ -62,6 +65,20 @@ Size Core::Item::hardcodedMaximumSize = Size(16777215, 16777215);
 bool Core::ItemBoxContainer::s_inhibitSimplify = false;
 LayoutingSeparator *LayoutingSeparator::s_separatorBeingDragged = nullptr;
 
+// AtomicGeometryCommit state
+static int s_numAtomicGeometryCommits = 0;
+static Vector<Item *> s_itemsWithPendingGeometry;
+static Vector<LayoutingSeparator *> s_separatorsWithPendingGeometry;
+
+/// Unlike Item::root(), also works for ItemFreeContainer. Returns nullptr for a parentless leaf.
+static ItemContainer *rootContainer(Item *item)
+{
+    while (item->parentContainer())
+        item = item->parentContainer();
+
+    return item->asContainer();
+}
+
 static bool locationIsVertical(Location loc)
 {
     return loc == Location_OnTop || loc == Location_OnBottom;
@@ -193,7 +210,16 @@ void Item::setGuest(LayoutingGuest *guest)
 {
     assert(!guest || !m_guest);
 
+    ItemContainer *root = rootContainer(this);
+    if (root && m_guest)
+        root->unindexGuests(this);
+
     m_guest = guest;
+
+    if (root && m_guest)
+        root->indexGuests(this);
+
+    markHostDirty();
     m_parentChangedConnection.disconnect();
     m_guestDestroyedConnection->disconnect();
     m_layoutInvalidatedConnection->disconnect();
@@ -236,7 +262,15 @@ void Item::setGuest(LayoutingGuest *guest)
 
 void Item::updateWidgetGeometries()
 {
-    if (m_guest) {
+    if (!m_guest)
+        return;
+
+    if (AtomicGeometryCommit::isActive()) {
+        if (!m_guestGeometryPending) {
+            m_guestGeometryPending = true;
+            AtomicGeometryCommit::addToList(this, s_itemsWithPendingGeometry);
+        }
+    } else {
         m_guest->setGeometry(mapToRoot(rect()));
     }
 }
@@ -306,6 +340,11 @@ int Item::refCount() const
     return m_refCount;
 }
 
+std::chrono::steady_clock::time_point Item::placeholderSince() const
+{
+    return m_placeholderSince;
+}
+
 LayoutingHost *Item::host() const
 {
     return m_host;
@@ -364,7 +403,9 @@ Vector<int> Item::pathFromRoot() const
 void Item::setHost(LayoutingHost *host)
 {
     if (m_host != host) {
+        markHostDirty();
         m_host = host;
+        markHostDirty();
         if (m_guest) {
             m_guest->setHost(host);
             m_guest->setVisible(true);
@@ -395,6 +436,7 @@ bool Item::isBeingInserted() const
 void Item::setBeingInserted(bool is)
 {
     m_sizingInfo.isBeingInserted = is;
+    invalidateSizeConstraints();
 
     // Trickle up the hierarchy too, as the parent might be hidden due to not having visible
     // children
@@ -428,9 +470,19 @@ void Item::setParentContainer(ItemContainer *parent)
         }
     }
 
+    if (m_parent)
+        rootContainer(m_parent)->unindexGuests(this);
+
     m_parent = parent;
     connectParent(parent); // Reused by the ctor too
 
+    if (parent) {
+        rootContainer(parent)->indexGuests(this);
+    } else if (auto c = asContainer()) {
+        // Became root, its own index is stale
+        c->invalidateGuestIndex();
+    }
+
     setParent(parent);
 }
 
@@ -510,6 +562,8 @@ void Item::setMinSize(Size sz)
 {
     if (sz != m_sizingInfo.minSize) {
         m_sizingInfo.minSize = sz;
+        markHostDirty();
+        invalidateSizeConstraints();
         minSizeChanged.emit(this);
         if (!m_isSettingGuest)
             setSize_recursive(size().expandedTo(sz));
@@ -520,6 +574,8 @@ void Item::setMaxSizeHint(Size sz)
 {
     if (sz != m_sizingInfo.maxSizeHint) {
         m_sizingInfo.maxSizeHint = sz;
+        markHostDirty();
+        invalidateSizeConstraints();
         maxSizeChanged.emit(this);
     }
 }
@@ -796,6 +852,10 @@ void Item::setIsVisible(bool is)
 {
     if (is != m_isVisible) {
         m_isVisible = is;
+        if (!is)
+            m_placeholderSince = std::chrono::steady_clock::now();
+        markHostDirty();
+        invalidateSizeConstraints();
         visibleChanged.emit(this, is);
     }
 
@@ -805,6 +865,12 @@ void Item::setIsVisible(bool is)
     }
 }
 
+void Item::markHostDirty()
+{
+    if (m_host)
+        m_host->markDirty();
+}
+
 void Item::setGeometry_recursive(Rect rect)
 {
     // Recursiveness doesn't apply for non-container items
@@ -834,7 +900,7 @@ bool Item::checkSanity()
         // Reminder: m_guest->geometry() is in the coordspace of the host widget (DropArea)
         // while Item::m_sizingInfo.geometry is in the coordspace of the parent container
 
-        if (m_guest->geometry() != mapToRoot(rect())) {
+        if (!m_guestGeometryPending && m_guest->geometry() != mapToRoot(rect())) {
             root()->dumpLayout();
             KDDW_ERROR("Guest widget doesn't have correct geometry. m_guest->guestGeometry={}, item.mapToRoot(rect())={}", m_guest->geometry(), mapToRoot(rect()));
             return false;
@@ -885,6 +951,7 @@ void Item::setGeometry(Rect rect)
             KDDW_ERROR("Constraints not honoured. this={}, sz={}, min={}, parent={}", ( void * )this, rect.size(), minSz, ( void * )parentContainer());
         }
 
+        markHostDirty();
         geometryChanged.emit();
 
         if (oldGeo.x() != x())
@@ -952,6 +1019,9 @@ Item::~Item()
     m_inDtor = true;
     safeEmitSignal(aboutToBeDeleted);
 
+    // Just null it, AtomicGeometryCommit::commit() might be iterating
+    AtomicGeometryCommit::removeFromList(this);
+
     m_minSizeChangedHandle.disconnect();
     m_visibleChangedHandle.disconnect();
     m_parentChangedConnection.disconnect();
@@ -971,6 +1041,9 @@ void Item::turnIntoPlaceholder()
 
 void Item::onGuestDestroyed()
 {
+    if (ItemContainer *root = rootContainer(this))
+        root->unindexGuests(this);
+
     m_guest = nullptr;
     m_parentChangedConnection.disconnect();
     m_guestDestroyedConnection->disconnect();
@@ -1096,9 +1169,7 @@ struct ItemBoxContainer::Private
 
     ~Private()
     {
-        for (const auto &sep : std::as_const(m_separators))
-            sep->free();
-        m_separators.clear();
+        deleteSeparators();
     }
 
     // length means height if the container is vertical, otherwise width
@@ -1126,6 +1197,7 @@ struct ItemBoxContainer::Private
     void deleteSeparators_recursive();
     void updateSeparators_recursive();
     Size minSize(const Item::List &items) const;
+    Size maxSizeHint() const;
     int excessLength() const;
 
     mutable bool m_checkSanityScheduled = false;
@@ -1135,9 +1207,25 @@ struct ItemBoxContainer::Private
     bool m_isDeserializing = false;
     bool m_isSimplifying = false;
     Qt::Orientation m_orientation = Qt::Vertical;
+    // See Item::invalidateSizeConstraints()
+    mutable std::optional<Size> m_cachedMinSize;
+    mutable std::optional<Size> m_cachedMaxSizeHint;
     ItemBoxContainer *const q;
 };
 
+void Item::invalidateSizeConstraints()
+{
+    // No early exit on an already invalid container, as min and max are cached independently
+    for (Item *item = this; item; item = item->m_parent) {
+        if (item->isContainer()) {
+            if (auto container = item->asBoxContainer()) {
+                container->d->m_cachedMinSize.reset();
+                container->d->m_cachedMaxSizeHint.reset();
+            }
+        }
+    }
+}
+
 ItemBoxContainer::ItemBoxContainer(LayoutingHost *hostWidget, ItemContainer *parent)
     : ItemContainer(hostWidget, parent)
     , d(new Private(this))
@@ -1332,7 +1420,8 @@ bool ItemBoxContainer::checkSanity()
             KDDW_ERROR("Unexpected separator position, expected={}, separator={}, this={}", separator->position(), expectedSeparatorPos, ( void * )separator, ( void * )this);
             return false;
         }
-        const Rect separatorGeometry = separator->geometry();
+        // Compared with the pending geometry during an AtomicGeometryCommit, like position() is
+        const Rect separatorGeometry = separator->effectiveGeometry();
         if (separatorGeometry.size() != expectedSeparatorSize) {
             KDDW_ERROR("Unexpected separator size={}, expected={}, separator={}, this={}", separatorGeometry.size(), expectedSeparatorSize, ( void * )separator, ( void * )this);
             return false;
@@ -1340,9 +1429,7 @@ bool ItemBoxContainer::checkSanity()
 
         const int separatorPos2 = Core::pos(separatorGeometry.topLeft(),
                                             oppositeOrientation(d->m_orientation));
-        if (Core::pos(separatorGeometry.topLeft(),
-                      oppositeOrientation(d->m_orientation))
-            != pos2) {
+        if (separatorPos2 != pos2) {
             root()->dumpLayout();
             KDDW_ERROR("Unexpected position pos2={}, expected={}, separator={}, this={}", separatorPos2, pos2, ( void * )separator, ( void * )this);
             return false;
@@ -1420,9 +1507,11 @@ void ItemBoxContainer::removeItem(Item *item, bool hardRemove)
 
     const bool isContainer = item->isContainer();
     const bool wasVisible = !isContainer && item->isVisible();
+    markHostDirty();
 
     if (hardRemove) {
         m_children.removeOne(item);
+        invalidateSizeConstraints();
         delete item;
         if (!isContainer)
             root()->numItemsChanged.emit();
@@ -1482,11 +1571,13 @@ ItemBoxContainer *ItemBoxContainer::convertChildToContainer(Item *leaf, const In
     insertItem(container, index, option);
 
     m_children.removeOne(leaf);
+    invalidateSizeConstraints();
     container->setGeometry(leaf->isVisible() ? leaf->geometry() : Rect());
     if (!leaf->isVisible())
         option.visibility = InitialVisibilityOption::StartHidden;
 
     container->insertItem(leaf, Location_OnTop, option);
+    markHostDirty();
     itemsChanged.emit();
     d->updateSeparators_recursive();
 
@@ -1553,6 +1644,7 @@ void ItemBoxContainer::insertItem(Item *item, Location loc,
         if (m_children.size() == 1) {
             // 2 items is the minimum to know which orientation we're layedout
             d->m_orientation = locOrientation;
+            invalidateSizeConstraints();
         }
 
         const auto index = locationIsSide1(loc) ? 0 : m_children.size();
@@ -1858,6 +1950,7 @@ void ItemBoxContainer::clear()
         delete item;
     }
     m_children.clear();
+    invalidateSizeConstraints();
     d->deleteSeparators();
 }
 
@@ -1948,7 +2041,9 @@ void ItemBoxContainer::insertItem(Item *item, int index, const InitialOption &op
     }
 
     m_children.insert(index, item);
+    invalidateSizeConstraints();
     item->setParentContainer(this);
+    markHostDirty();
 
     itemsChanged.emit();
 
@@ -1992,6 +2087,7 @@ int ItemBoxContainer::usableLength() const
 void ItemBoxContainer::setChildren(const List &children, Qt::Orientation o)
 {
     m_children = children;
+    invalidateSizeConstraints();
     for (Item *item : children)
         item->setParentContainer(this);
 
@@ -2002,6 +2098,8 @@ void ItemBoxContainer::setOrientation(Qt::Orientation o)
 {
     if (o != d->m_orientation) {
         d->m_orientation = o;
+        markHostDirty();
+        invalidateSizeConstraints();
         d->updateSeparators_recursive();
     }
 }
@@ -2037,15 +2135,27 @@ Size ItemBoxContainer::Private::minSize(const Item::List &items) const
 
 Size ItemBoxContainer::minSize() const
 {
-    return d->minSize(m_children);
+    // Cached, as it's queried for every ancestor on each resize and separator move
+    if (!d->m_cachedMinSize)
+        d->m_cachedMinSize = d->minSize(m_children);
+
+    return *d->m_cachedMinSize;
 }
 
 Size ItemBoxContainer::maxSizeHint() const
 {
-    int maxW = isVertical() ? hardcodedMaximumSize.width() : 0;
-    int maxH = isVertical() ? 0 : hardcodedMaximumSize.height();
+    if (!d->m_cachedMaxSizeHint)
+        d->m_cachedMaxSizeHint = d->maxSizeHint();
+
+    return *d->m_cachedMaxSizeHint;
+}
+
+Size ItemBoxContainer::Private::maxSizeHint() const
+{
+    int maxW = q->isVertical() ? Item::hardcodedMaximumSize.width() : 0;
+    int maxH = q->isVertical() ? 0 : Item::hardcodedMaximumSize.height();
 
-    const Item::List visibleChildren = this->visibleChildren(/*includeBeingInserted=*/false);
+    const Item::List visibleChildren = q->visibleChildren(/*includeBeingInserted=*/false);
     if (!visibleChildren.isEmpty()) {
         for (Item *item : visibleChildren) {
             if (item->isBeingInserted())
@@ -2053,30 +2163,30 @@ Size ItemBoxContainer::maxSizeHint() const
             const Size itemMaxSz = item->maxSizeHint();
             const int itemMaxWidth = itemMaxSz.width();
             const int itemMaxHeight = itemMaxSz.height();
-            if (isVertical()) {
+            if (q->isVertical()) {
                 maxW = std::min(maxW, itemMaxWidth);
-                maxH = std::min(maxH + itemMaxHeight, hardcodedMaximumSize.height());
+                maxH = std::min(maxH + itemMaxHeight, Item::hardcodedMaximumSize.height());
             } else {
                 maxH = std::min(maxH, itemMaxHeight);
-                maxW = std::min(maxW + itemMaxWidth, hardcodedMaximumSize.width());
+                maxW = std::min(maxW + itemMaxWidth, Item::hardcodedMaximumSize.width());
             }
         }
 
-        const auto separatorWaste = (int(visibleChildren.size()) - 1) * layoutSpacing;
-        if (isVertical()) {
-            maxH = std::min(maxH + separatorWaste, hardcodedMaximumSize.height());
+        const auto separatorWaste = (int(visibleChildren.size()) - 1) * Item::layoutSpacing;
+        if (q->isVertical()) {
+            maxH = std::min(maxH + separatorWaste, Item::hardcodedMaximumSize.height());
         } else {
-            maxW = std::min(maxW + separatorWaste, hardcodedMaximumSize.width());
+            maxW = std::min(maxW + separatorWaste, Item::hardcodedMaximumSize.width());
         }
     }
 
     if (maxW == 0)
-        maxW = hardcodedMaximumSize.width();
+        maxW = Item::hardcodedMaximumSize.width();
 
     if (maxH == 0)
-        maxH = hardcodedMaximumSize.height();
+        maxH = Item::hardcodedMaximumSize.height();
 
-    return Size(maxW, maxH).expandedTo(d->minSize(visibleChildren));
+    return Size(maxW, maxH).expandedTo(minSize(visibleChildren));
 }
 
 void ItemBoxContainer::Private::resizeChildren(Size oldSize, Size newSize,
@@ -2182,6 +2292,7 @@ void ItemBoxContainer::Private::honourMaxSizes(SizingInfo::List &sizes)
     // Reduces the size of all children that are bigger than max-size.
     // Assuming there's widgets that are willing to grow to occupy that space.
 
+    KDDW_PROFILE_SCOPE("ItemBoxContainer::honourMaxSizes");
     int amountNeededToShrink = 0;
     int amountAvailableToGrow = 0;
     Vector<int> indexesOfShrinkers;
@@ -2279,6 +2390,7 @@ bool ItemBoxContainer::hostSupportsHonouringLayoutMinSize() const
 void ItemBoxContainer::setSize_recursive(Size newSize, ChildrenResizeStrategy strategy)
 {
     ScopedValueRollback block(d->m_blockUpdatePercentages, true);
+    AtomicGeometryCommit geometryCommit;
 
     const Size minSize = this->minSize();
     if (newSize.width() < minSize.width() || newSize.height() < minSize.height()) {
@@ -2380,6 +2492,7 @@ void ItemBoxContainer::updateChildPercentages()
     if (root()->d->m_blockUpdatePercentages)
         return;
 
+    markHostDirty();
     const int usable = usableLength();
     for (Item *item : std::as_const(m_children)) {
         if (item->isVisible() && !item->isBeingInserted()) {
@@ -2503,6 +2616,7 @@ void ItemBoxContainer::requestSeparatorMove(LayoutingSeparator *separator,
     if (delta == 0)
         return;
 
+    AtomicGeometryCommit geometryCommit;
     const int min = minPosForSeparator_global(separator);
     const int pos = separator->position();
     const int max = maxPosForSeparator_global(separator);
@@ -2735,6 +2849,7 @@ void ItemBoxContainer::layoutEqually(SizingInfo::List &sizes)
 
 void ItemBoxContainer::layoutEqually_recursive()
 {
+    AtomicGeometryCommit geometryCommit;
     layoutEqually();
     for (Item *item : std::as_const(m_children)) {
         if (item->isVisible()) {
@@ -3035,6 +3150,7 @@ void ItemBoxContainer::growItem(int index, SizingInfo::List &sizes, int missing,
                                 NeighbourSqueezeStrategy neighbourSqueezeStrategy,
                                 bool accountForNewSeparator)
 {
+    KDDW_PROFILE_SCOPE("ItemBoxContainer::growItem");
     int toSteal = missing; // The amount that neighbours of @p index will shrink
     if (accountForNewSeparator)
         toSteal += Item::layoutSpacing;
@@ -3170,10 +3286,15 @@ void ItemBoxContainer::applyGeometries(const SizingInfo::List &sizes,
 
 SizingInfo::List ItemBoxContainer::sizes(bool ignoreBeingInserted) const
 {
-    const Item::List children = visibleChildren(ignoreBeingInserted);
     SizingInfo::List result;
-    result.reserve(children.count());
-    for (Item *item : children) {
+    result.reserve(m_children.count());
+    for (Item *item : std::as_const(m_children)) {
+        // Same filter as visibleChildren(), minus the temporary list
+        const bool isVisible = ignoreBeingInserted ? (item->isVisible() || item->isBeingInserted())
+                                                   : (item->isVisible() && !item->isBeingInserted());
+        if (!isVisible)
+            continue;
+
         if (item->isContainer()) {
             // Containers have virtual min/maxSize methods, and don't really fill in these
             // properties So fill them here
@@ -3191,6 +3312,7 @@ Vector<int> ItemBoxContainer::calculateSqueezes(
     SizingInfo::List::const_iterator end, int needed, // clazy:exclude=function-args-by-ref
     NeighbourSqueezeStrategy strategy, bool reversed) const
 {
+    KDDW_PROFILE_SCOPE("ItemBoxContainer::calculateSqueezes");
     Vector<int> availabilities;
     for (auto it = begin; it < end; ++it) {
         availabilities.push_back(it->availableLength(d->m_orientation));
@@ -3258,6 +3380,7 @@ Vector<int> ItemBoxContainer::calculateSqueezes(
 void ItemBoxContainer::shrinkNeighbours(int index, SizingInfo::List &sizes, int side1Amount,
                                         int side2Amount, NeighbourSqueezeStrategy strategy)
 {
+    KDDW_PROFILE_SCOPE("ItemBoxContainer::shrinkNeighbours");
     assert(side1Amount > 0 || side2Amount > 0);
     assert(side1Amount >= 0 && side2Amount >= 0); // never negative
 
@@ -3310,6 +3433,7 @@ Vector<int> ItemBoxContainer::Private::requiredSeparatorPositions() const
 
 void ItemBoxContainer::Private::updateSeparators()
 {
+    KDDW_PROFILE_SCOPE("ItemBoxContainer::updateSeparators");
     if (!q->host())
         return;
 
@@ -3330,7 +3454,9 @@ void ItemBoxContainer::Private::updateSeparators()
                 newSeparators.push_back(separator);
                 m_separators.removeOne(separator);
             } else {
-                separator = s_createSeparatorFunc(q->host(), m_orientation, q);
+                separator = q->host()->takeRecycledSeparator(m_orientation, q);
+                if (!separator)
+                    separator = s_createSeparatorFunc(q->host(), m_orientation, q);
                 newSeparators.push_back(separator);
             }
         }
@@ -3360,8 +3486,11 @@ void ItemBoxContainer::Private::updateSeparators()
 
 void ItemBoxContainer::Private::deleteSeparators()
 {
-    for (const auto &sep : std::as_const(m_separators))
-        sep->free();
+    for (const auto &sep : std::as_const(m_separators)) {
+        // Separator views are children of the host they were created for, so go back to that pool
+        if (!sep->m_host->recycleSeparator(sep))
+            sep->free();
+    }
     m_separators.clear();
 }
 
@@ -3399,6 +3528,7 @@ void ItemBoxContainer::simplify()
     // Removes unneeded nesting. For example, a vertical layout doesn't need to have vertical
     // layouts inside. It can simply have the contents of said sub-layouts
 
+    KDDW_PROFILE_SCOPE("ItemBoxContainer::simplify");
     ScopedValueRollback isInSimplify(d->m_isSimplifying, true);
 
     Item::List newChildren;
@@ -3429,11 +3559,21 @@ void ItemBoxContainer::simplify()
 
     if (m_children != newChildren) {
         m_children = newChildren;
+        invalidateSizeConstraints();
         positionItems();
         updateChildPercentages();
     }
 }
 
+int ItemBoxContainer::collapseRedundantContainers()
+{
+    const int numContainersBefore = containerCount_recursive();
+    simplify();
+    d->updateSeparators_recursive();
+
+    return numContainersBefore - containerCount_recursive();
+}
+
 LayoutingSeparator *ItemBoxContainer::Private::separatorAt(int p) const
 {
     for (auto separator : m_separators) {
@@ -3558,7 +3698,10 @@ void ItemBoxContainer::fillFromJson(const nlohmann::json &j,
         m_children.push_back(childItem);
     }
 
+    invalidateSizeConstraints();
+
     if (isRoot()) {
+        markHostDirty();
         updateChildPercentages_recursive();
         if (host()) {
             d->updateSeparators_recursive();
@@ -3983,6 +4126,12 @@ struct ItemContainer::Private
     {
     }
     ItemContainer *const q;
+
+    /// Guest to Item, for itemForView(). Only the root's is used.
+    /// Deleted items aren't removed eagerly, the guard nulls them and lookups skip them.
+    std::unordered_map<const LayoutingGuest *, ObjectGuard<Item>> m_guestIndex;
+    /// When set, m_guestIndex is rebuilt on the next lookup
+    bool m_guestIndexDirty = true;
 };
 
 ItemContainer::ItemContainer(LayoutingHost *hostWidget, ItemContainer *parent)
@@ -4070,18 +4219,92 @@ bool ItemContainer::contains(const Item *item) const
 
 Item *ItemContainer::itemForView(const LayoutingGuest *w) const
 {
-    for (Item *item : std::as_const(m_children)) {
-        if (item->isContainer()) {
-            if (Item *result = item->asContainer()->itemForView(w))
-                return result;
-        } else if (item->guest() == w) {
-            return item;
+    if (!w) {
+        // Not indexed, placeholders have no guest
+        for (Item *item : itemRange_recursive()) {
+            if (!item->guest())
+                return item;
         }
+
+        return nullptr;
+    }
+
+    ItemContainer *root = rootContainer(const_cast<ItemContainer *>(this));
+    Private *rd = root->d;
+    if (rd->m_guestIndexDirty) {
+        rd->m_guestIndex.clear();
+        root->visit_recursive([rd](Item *item) {
+            if (item->guest())
+                rd->m_guestIndex.try_emplace(item->guest(), item);
+            return true;
+        });
+        rd->m_guestIndexDirty = false;
+    }
+
+    auto it = rd->m_guestIndex.find(w);
+    if (it == rd->m_guestIndex.end())
+        return nullptr;
+
+    Item *item = it->second;
+    if (!item || item->guest() != w) {
+        // Item was deleted meanwhile
+        rd->m_guestIndex.erase(it);
+        return nullptr;
+    }
+
+    // The index is per tree, we might have been called on a sub-container
+    for (Item *p = item->parentContainer(); p; p = p->parentContainer()) {
+        if (p == this)
+            return item;
     }
 
     return nullptr;
 }
 
+void ItemContainer::indexGuests(Item *item)
+{
+    if (d->m_guestIndexDirty)
+        return;
+
+    if (auto c = item->asContainer()) {
+        c->visit_recursive([this](Item *leaf) {
+            if (leaf->guest())
+                d->m_guestIndex.try_emplace(leaf->guest(), leaf);
+            return true;
+        });
+    } else if (item->guest()) {
+        d->m_guestIndex[item->guest()] = item;
+    }
+}
+
+void ItemContainer::invalidateGuestIndex()
+{
+    d->m_guestIndex.clear();
+    d->m_guestIndexDirty = true;
+}
+
+void ItemContainer::unindexGuests(Item *item)
+{
+    if (d->m_guestIndexDirty)
+        return;
+
+    auto unindex = [this](Item *leaf) {
+        if (!leaf->guest())
+            return true;
+
+        auto it = d->m_guestIndex.find(leaf->guest());
+        if (it != d->m_guestIndex.end() && it->second == leaf)
+            d->m_guestIndex.erase(it);
+        return true;
+    };
+
+    if (auto c = item->asContainer()) {
+        c->visit_recursive(unindex);
+    } else {
+        unindex(item);
+    }
+}
+
 Item::List ItemContainer::visibleChildren(bool includeBeingInserted) const
 {
     Item::List items;
@@ -4103,15 +4326,84 @@ Item::List ItemContainer::items_recursive() const
 {
     Item::List items;
     items.reserve(30); // sounds like a good upper number to minimize allocations
-    for (Item *item : std::as_const(m_children)) {
-        if (auto c = item->asContainer()) {
-            items.append(c->items_recursive());
+    visit_recursive([&items](Item *item) {
+        items.push_back(item);
+        return true;
+    });
+
+    return items;
+}
+
+ItemTreeRange ItemContainer::itemRange_recursive() const
+{
+    return ItemTreeRange(this, /*visibleOnly=*/false);
+}
+
+ItemTreeRange ItemContainer::visibleItemRange_recursive() const
+{
+    return ItemTreeRange(this, /*visibleOnly=*/true);
+}
+
+ItemTreeRange::ItemTreeRange(const ItemContainer *root, bool visibleOnly)
+    : m_root(root)
+    , m_visibleOnly(visibleOnly)
+{
+}
+
+ItemTreeRange::Iterator ItemTreeRange::begin() const
+{
+    Iterator it(this);
+    if (!m_root->m_children.isEmpty()) {
+        it.m_stack.push_back({ m_root, 0 });
+        it.advance();
+    }
+
+    return it;
+}
+
+ItemTreeRange::Iterator ItemTreeRange::end() const
+{
+    return Iterator(this);
+}
+
+ItemTreeRange::Iterator::Iterator(const ItemTreeRange *range)
+    : m_range(range)
+{
+}
+
+void ItemTreeRange::Iterator::advance()
+{
+    while (!m_stack.empty()) {
+        Level &level = m_stack.back();
+        if (level.index >= level.container->m_children.size()) {
+            m_stack.pop_back();
+            if (!m_stack.empty())
+                ++m_stack.back().index;
+            continue;
+        }
+
+        Item *item = level.container->m_children.at(level.index);
+        if (item->isContainer()) {
+            m_stack.push_back({ static_cast<const ItemContainer *>(item), 0 });
+        } else if (m_range->m_visibleOnly && !item->isVisible()) {
+            ++level.index;
         } else {
-            items.push_back(item);
+            m_item = item;
+            return;
         }
     }
 
-    return items;
+    m_item = nullptr;
+}
+
+ItemTreeRange::Iterator &ItemTreeRange::Iterator::operator++()
+{
+    if (!m_stack.empty()) {
+        ++m_stack.back().index;
+        advance();
+    }
+
+    return *this;
 }
 
 bool ItemContainer::contains_recursive(const Item *item) const
@@ -4153,6 +4445,17 @@ int ItemContainer::count_recursive() const
     return count;
 }
 
+int ItemContainer::containerCount_recursive() const
+{
+    int count = 1;
+    for (Item *item : std::as_const(m_children)) {
+        if (auto c = item->asContainer())
+            count += c->containerCount_recursive();
+    }
+
+    return count;
+}
+
 bool ItemContainer::inSetSize() const
 {
     return std::any_of(m_children.cbegin(), m_children.cend(), [](Item *child) {
@@ -4160,8 +4463,78 @@ bool ItemContainer::inSetSize() const
     });
 }
 
-LayoutingHost::~LayoutingHost() = default;
-LayoutingSeparator::~LayoutingSeparator() = default;
+/// Source for LayoutingHost::generation(), shared by all hosts so values are never reused
+static uint64_t s_lastLayoutGeneration = 0;
+
+LayoutingHost::LayoutingHost()
+    : m_generation(++s_lastLayoutGeneration)
+{
+}
+
+LayoutingHost::~LayoutingHost()
+{
+    clearRecycledSeparators();
+}
+
+void LayoutingHost::markDirty()
+{
+    m_generation = ++s_lastLayoutGeneration;
+}
+
+LayoutingSeparator *LayoutingHost::takeRecycledSeparator(Qt::Orientation o, ItemBoxContainer *container)
+{
+    // Most recently recycled first, they're the likeliest to still be warm
+    for (int i = m_recycledSeparators.size() - 1; i >= 0; --i) {
+        LayoutingSeparator *separator = m_recycledSeparators.at(i);
+        if (separator->orientation() == o) {
+            m_recycledSeparators.removeAt(i);
+            separator->m_parentContainer = container;
+            separator->onReused();
+            return separator;
+        }
+    }
+
+    return nullptr;
+}
+
+bool LayoutingHost::recycleSeparator(LayoutingSeparator *separator)
+{
+    if (separator == LayoutingSeparator::s_separatorBeingDragged)
+        return false;
+
+    int numSameOrientation = 0;
+    for (LayoutingSeparator *recycled : std::as_const(m_recycledSeparators)) {
+        if (recycled->orientation() == separator->orientation())
+            ++numSameOrientation;
+    }
+
+    if (numSameOrientation >= Item::maxRecycledSeparators)
+        return false;
+
+    separator->discardPendingGeometry();
+    separator->m_parentContainer = nullptr;
+    separator->onRecycled();
+    m_recycledSeparators.push_back(separator);
+    return true;
+}
+
+void LayoutingHost::clearRecycledSeparators()
+{
+    const auto separators = std::move(m_recycledSeparators);
+    m_recycledSeparators.clear();
+    for (LayoutingSeparator *separator : separators)
+        separator->free();
+}
+
+int LayoutingHost::numRecycledSeparators() const
+{
+    return m_recycledSeparators.size();
+}
+
+LayoutingSeparator::~LayoutingSeparator()
+{
+    discardPendingGeometry();
+}
 
 LayoutingSeparator::LayoutingSeparator(LayoutingHost *host, Qt::Orientation orientation, Core::ItemBoxContainer *container)
     : m_host(host)
@@ -4175,9 +4548,14 @@ bool LayoutingSeparator::isVertical() const
     return m_orientation == Qt::Vertical;
 }
 
+Rect LayoutingSeparator::effectiveGeometry() const
+{
+    return m_geometryPending ? m_pendingGeometry : geometry();
+}
+
 int LayoutingSeparator::position() const
 {
-    const Point topLeft = geometry().topLeft();
+    const Point topLeft = effectiveGeometry().topLeft();
     return (isVertical() ? topLeft.y() : topLeft.x()) - offset();
 }
 
@@ -4206,7 +4584,15 @@ void LayoutingSeparator::setGeometry(int pos, int pos2, int length)
         newGeo.moveTo(pos, pos2);
     }
 
-    setGeometry(newGeo);
+    if (AtomicGeometryCommit::isActive()) {
+        m_pendingGeometry = newGeo;
+        if (!m_geometryPending) {
+            m_geometryPending = true;
+            AtomicGeometryCommit::addToList(this, s_separatorsWithPendingGeometry);
+        }
+    } else {
+        setGeometry(newGeo);
+    }
 }
 
 void LayoutingSeparator::free()
@@ -4214,6 +4600,21 @@ void LayoutingSeparator::free()
     delete this;
 }
 
+void LayoutingSeparator::onRecycled()
+{
+}
+
+void LayoutingSeparator::onReused()
+{
+}
+
+void LayoutingSeparator::discardPendingGeometry()
+{
+    // A pending AtomicGeometryCommit must not apply the old geometry to a recycled separator
+    AtomicGeometryCommit::removeFromList(this);
+    m_geometryPending = false;
+}
+
 bool LayoutingSeparator::isBeingDragged() const
 {
     return LayoutingSeparator::s_separatorBeingDragged != nullptr;
@@ -4271,6 +4672,151 @@ void LayoutingSeparator::raise()
     // For QtWidgets/QtQuick we do support it though.
 }
 
+AtomicGeometryCommit::AtomicGeometryCommit()
+{
+    s_numAtomicGeometryCommits++;
+}
+
+AtomicGeometryCommit::~AtomicGeometryCommit()
+{
+    s_numAtomicGeometryCommits--;
+    if (s_numAtomicGeometryCommits == 0)
+        commit();
+}
+
+bool AtomicGeometryCommit::isActive()
+{
+    return s_numAtomicGeometryCommits > 0;
+}
+
+template<typename T>
+void AtomicGeometryCommit::addToList(T *obj, Vector<T *> &list)
+{
+    removeFromList(obj);
+    obj->m_pendingGeometryList = &list;
+    obj->m_pendingGeometryIndex = int(list.size());
+    list.push_back(obj);
+}
+
+template<typename T>
+void AtomicGeometryCommit::removeFromList(T *obj)
+{
+    if (obj->m_pendingGeometryList) {
+        (*obj->m_pendingGeometryList)[obj->m_pendingGeometryIndex] = nullptr;
+        obj->m_pendingGeometryList = nullptr;
+        obj->m_pendingGeometryIndex = -1;
+    }
+}
+
+template<typename T>
+void AtomicGeometryCommit::takeList(Vector<T *> &from, Vector<T *> &to)
+{
+    to = std::move(from);
+    from.clear();
+    for (T *obj : std::as_const(to)) {
+        if (obj)
+            obj->m_pendingGeometryList = &to;
+    }
+}
+
+template<typename T>
+void AtomicGeometryCommit::releaseList(Vector<T *> &list)
+{
+    for (T *obj : std::as_const(list)) {
+        if (obj) {
+            obj->m_pendingGeometryList = nullptr;
+            obj->m_pendingGeometryIndex = -1;
+        }
+    }
+}
+
+void AtomicGeometryCommit::commit()
+{
+    if (s_itemsWithPendingGeometry.isEmpty() && s_separatorsWithPendingGeometry.isEmpty())
+        return;
+
+    // A guest reacting to its new geometry might delete items or separators, which null their
+    // entries, or open a scope of its own, which commits new lists
+    Vector<Item *> items;
+    Vector<LayoutingSeparator *> separators;
+    takeList(s_itemsWithPendingGeometry, items);
+    takeList(s_separatorsWithPendingGeometry, separators);
+
+    // Apply in tree order, starting at each affected root. The order is collected before calling
+    // any guest, as indexes into the lists, as the tree might change meanwhile.
+    Vector<ItemBoxContainer *> roots;
+    for (Item *item : std::as_const(items)) {
+        if (auto root = item ? item->root() : nullptr) {
+            if (!roots.contains(root))
+                roots.push_back(root);
+        }
+    }
+
+    for (LayoutingSeparator *separator : std::as_const(separators)) {
+        if (auto root = separator ? separator->parentContainer()->root() : nullptr) {
+            if (!roots.contains(root))
+                roots.push_back(root);
+        }
+    }
+
+    std::vector<Entry> order;
+    order.reserve(items.size() + separators.size());
+    for (ItemBoxContainer *root : std::as_const(roots))
+        collect_recursive(root, items, separators, order);
+
+    auto applyItem = [&items](int index) {
+        Item *item = items.at(index);
+        if (item && item->m_guestGeometryPending) {
+            item->m_guestGeometryPending = false;
+            item->updateWidgetGeometries();
+        }
+    };
+
+    auto applySeparator = [&separators](int index) {
+        LayoutingSeparator *separator = separators.at(index);
+        if (separator && separator->m_geometryPending) {
+            separator->m_geometryPending = false;
+            separator->setGeometry(separator->m_pendingGeometry);
+        }
+    };
+
+    for (Entry entry : order) {
+        if (entry.isSeparator)
+            applySeparator(entry.index);
+        else
+            applyItem(entry.index);
+    }
+
+    // Whatever wasn't reachable from a root, for example items that were removed from the layout
+    for (int i = 0; i < items.size(); ++i)
+        applyItem(i);
+
+    for (int i = 0; i < separators.size(); ++i)
+        applySeparator(i);
+
+    releaseList(items);
+    releaseList(separators);
+}
+
+void AtomicGeometryCommit::collect_recursive(Item *item, const Vector<Item *> &items,
+                                             const Vector<LayoutingSeparator *> &separators, std::vector<Entry> &order)
+{
+    if (item->m_guestGeometryPending && item->m_pendingGeometryList == &items)
+        order.push_back({ item->m_pendingGeometryIndex, false });
+
+    if (auto container = item->asContainer()) {
+        for (Item *child : std::as_const(container->m_children))
+            collect_recursive(child, items, separators, order);
+
+        if (auto box = item->asBoxContainer()) {
+            for (LayoutingSeparator *separator : std::as_const(box->d->m_separators)) {
+                if (separator->m_geometryPending && separator->m_pendingGeometryList == &separators)
+                    order.push_back({ separator->m_pendingGeometryIndex, true });
+            }
+        }
+    }
+}
+
 class LayoutingGuest::Private
 {
 public:
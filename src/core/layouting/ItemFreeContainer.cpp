@@ -14,22 +14,34 @@
 
 #include "core/View.h"
 #include "core/Logging_p.h"
+#include "core/SpatialIndex_p.h"
 #include "core/Utils_p.h"
 
 using namespace KDDockWidgets::Core;
 
+struct ItemFreeContainer::Private
+{
+    /// Visible children by geometry, top-most first. See itemAt()
+    SpatialIndex<Item *> m_index;
+    /// The layout generation m_index was built for. See LayoutingHost::generation()
+    uint64_t m_indexGeneration = 0;
+};
+
 ItemFreeContainer::ItemFreeContainer(LayoutingHost *hostWidget, ItemContainer *parent)
     : ItemContainer(hostWidget, parent)
+    , d(new Private())
 {
 }
 
 ItemFreeContainer::ItemFreeContainer(LayoutingHost *hostWidget)
     : ItemContainer(hostWidget)
+    , d(new Private())
 {
 }
 
 ItemFreeContainer::~ItemFreeContainer()
 {
+    delete d;
 }
 
 void ItemFreeContainer::addDockWidget(Item *item, Point localPt)
@@ -44,6 +56,7 @@ void ItemFreeContainer::addDockWidget(Item *item, Point localPt)
     m_children.append(item);
     item->setParentContainer(this);
     item->setPos(localPt);
+    markHostDirty();
 
     itemsChanged.emit();
 
@@ -74,9 +87,61 @@ void ItemFreeContainer::removeItem(Item *item, bool hardRemove)
     if (wasVisible)
         numVisibleItemsChanged.emit(numVisibleChildren());
 
+    markHostDirty();
     itemsChanged.emit();
 }
 
+void ItemFreeContainer::raiseItem(Item *item)
+{
+    const int index = m_children.indexOf(item);
+    if (index == -1) {
+        KDDW_ERROR("Item not found in this container");
+        return;
+    }
+
+    if (index == m_children.size() - 1)
+        return;
+
+    m_children.move(index, m_children.size() - 1);
+
+    // Stacking is saved as well, as the children order
+    markHostDirty();
+    itemsChanged.emit();
+}
+
+Item *ItemFreeContainer::itemAt(Point localPt) const
+{
+    updateIndex();
+    return d->m_index.valueAt(localPt);
+}
+
+Item::List ItemFreeContainer::itemsIntersecting(Rect localRect) const
+{
+    updateIndex();
+
+    Item::List result;
+    d->m_index.visitIntersecting(localRect, [&result](Item *item) { result.push_back(item); });
+    return result;
+}
+
+void ItemFreeContainer::updateIndex() const
+{
+    // Without a host there's no generation to compare against, so always rebuild
+    const uint64_t generation = host() ? host()->generation() : 0;
+    if (generation != 0 && generation == d->m_indexGeneration)
+        return;
+
+    std::vector<std::pair<Rect, Item *>> entries;
+    entries.reserve(size_t(m_children.size()));
+    for (auto it = m_children.crbegin(); it != m_children.crend(); ++it) {
+        if ((*it)->isVisible())
+            entries.push_back({ (*it)->geometry(), *it });
+    }
+
+    d->m_index.build(std::move(entries));
+    d->m_indexGeneration = generation;
+}
+
 void ItemFreeContainer::restore(Item *child)
 {
     child->setIsVisible(true);
@@ -35,14 +35,29 @@ public:
     explicit ItemFreeContainer(LayoutingHost *hostWidget);
     ~ItemFreeContainer();
 
-    /// @brief adds the item to the specified position
+    /// @brief adds the item to the specified position, on top of the existing ones
     void addDockWidget(Item *item, Point localPt);
 
+    /// @brief Puts @p item on top of its siblings
+    /// childItems() is in stacking order, bottom-most first.
+    void raiseItem(Item *item);
+
+    /// @brief Returns the top-most visible item containing @p localPt
+    Item *itemAt(Point localPt) const;
+
+    /// @brief Returns the visible items intersecting @p localRect, top-most first
+    Item::List itemsIntersecting(Rect localRect) const;
+
     void clear() override;
     void removeItem(Item *, bool hardRemove = true) override;
     void restore(Item *child) override;
     void onChildMinSizeChanged(Item *child) override;
     void onChildVisibleChanged(Item *child, bool visible) override;
+
+private:
+    void updateIndex() const;
+    struct Private;
+    Private *const d;
 };
 
 }
@@ -17,8 +17,12 @@
 #include "kdbindings/signal.h"
 #include "nlohmann/json.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace KDDockWidgets {
 
@@ -29,6 +33,8 @@ class ItemContainer;
 class ItemBoxContainer;
 class Item;
 struct LengthOnSide;
+struct AtomicGeometryCommit;
+class ItemTreeRange;
 
 class LayoutingHost;
 class LayoutingGuest;
@@ -215,6 +221,10 @@ public:
     /// of the dockwidgets, which can be useful in certain styles.
     static int layoutSpacing;
 
+    /// How many unused separators each LayoutingHost keeps around, per orientation, to reuse
+    /// when a container needs new ones. 0 disables recycling.
+    static int maxRecycledSeparators;
+
     int x() const;
     int y() const;
     int width() const;
@@ -271,6 +281,10 @@ public:
     int refCount() const;
     void turnIntoPlaceholder();
 
+    /// Returns when this item was last hidden, or when it was created if it never was.
+    /// Used to find old placeholders, see Layout::compactPlaceholders()
+    std::chrono::steady_clock::time_point placeholderSince() const;
+
     int minLength(Qt::Orientation) const;
     int maxLengthHint(Qt::Orientation) const;
 
@@ -339,6 +353,12 @@ public:
     bool isBeingInserted() const;
     void setBeingInserted(bool);
 
+    /// Tells the host that its serialized layout changed. See LayoutingHost::generation()
+    void markHostDirty();
+    /// Drops the cached min and max sizes of this item's containers, up to the root.
+    /// Call it after changing anything their minSize() or maxSizeHint() depend on.
+    void invalidateSizeConstraints();
+
     SizingInfo m_sizingInfo;
     const bool m_isContainer;
     ItemContainer *m_parent = nullptr;
@@ -351,7 +371,14 @@ private:
     friend class ItemContainer;
     friend class ItemBoxContainer;
     friend class ItemFreeContainer;
+    friend struct AtomicGeometryCommit;
     int m_refCount = 0;
+    std::chrono::steady_clock::time_point m_placeholderSince = std::chrono::steady_clock::now();
+    bool m_guestGeometryPending = false;
+    /// The AtomicGeometryCommit list this item is in, and where. Kept while being committed,
+    /// even after m_guestGeometryPending is cleared, so the destructor can null the entry.
+    Vector<Item *> *m_pendingGeometryList = nullptr;
+    int m_pendingGeometryIndex = -1;
     void onGuestDestroyed();
     bool m_isVisible = false;
     bool m_inSetSize = false;
@@ -389,12 +416,39 @@ public:
     int indexOfChild(const Item *child) const;
     bool isEmpty() const;
     bool contains(const Item *item) const;
+    /// Returns the item in this subtree hosting the specified guest
+    /// Doesn't walk the tree, uses an index maintained by the root container
     Item *itemForView(const LayoutingGuest *) const;
     Item::List visibleChildren(bool includeBeingInserted = false) const;
     Item::List items_recursive() const;
+
+    /// Same items as items_recursive(), but iterated in place instead of copied into a list
+    ItemTreeRange itemRange_recursive() const;
+    /// Like itemRange_recursive(), but skips hidden items (placeholders)
+    ItemTreeRange visibleItemRange_recursive() const;
+
+    /// Calls @p visitor with each item items_recursive() would return, in the same order,
+    /// without allocating. The visitor returns false to stop early.
+    /// Returns false if the visit was stopped.
+    template<typename Visitor>
+    bool visit_recursive(Visitor &&visitor) const
+    {
+        for (Item *item : m_children) {
+            if (item->isContainer()) {
+                if (!static_cast<const ItemContainer *>(item)->visit_recursive(visitor))
+                    return false;
+            } else if (!visitor(item)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
     bool contains_recursive(const Item *item) const;
     int visibleCount_recursive() const override;
     int count_recursive() const;
+    /// Returns how many containers there are in this subtree, including this one
+    int containerCount_recursive() const;
     virtual void clear() = 0;
     bool inSetSize() const override;
 
@@ -406,12 +460,82 @@ public:
 protected:
     bool hasSingleVisibleItem() const;
     Item::List m_children;
+    friend struct AtomicGeometryCommit;
+    friend class ItemTreeRange;
 
 private:
+    friend class Item;
+    /// Keeps the root's guest index, used by itemForView(), up to date
+    void indexGuests(Item *);
+    void unindexGuests(Item *);
+    void invalidateGuestIndex();
     struct Private;
     Private *const d;
 };
 
+/// @brief Depth-first range over the non-container items of a tree, see ItemContainer::itemRange_recursive()
+/// The iterator keeps the child index of each container it's inside of, so each step is O(1)
+/// amortized, and it only allocates for that, once per traversal.
+/// The tree must not be modified while iterating.
+class DOCKS_EXPORT ItemTreeRange
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Item *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Item *const *;
+        using reference = Item *const &;
+
+        reference operator*() const
+        {
+            return m_item;
+        }
+
+        Iterator &operator++();
+
+        bool operator==(const Iterator &other) const
+        {
+            return m_item == other.m_item;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return m_item != other.m_item;
+        }
+
+    private:
+        friend class ItemTreeRange;
+        explicit Iterator(const ItemTreeRange *range);
+
+        /// Moves to the first accepted item at or after the current position
+        void advance();
+
+        struct Level
+        {
+            const ItemContainer *container;
+            int index;
+        };
+
+        const ItemTreeRange *m_range;
+        Item *m_item = nullptr;
+        /// The containers from the root down to m_item's parent, empty at the end
+        std::vector<Level> m_stack;
+    };
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    friend class ItemContainer;
+    ItemTreeRange(const ItemContainer *root, bool visibleOnly);
+
+    const ItemContainer *const m_root;
+    const bool m_visibleOnly;
+};
+
 /// @brief A container for items which can either be vertical or horizontal
 ///
 /// Similar analogy to QBoxLayout
@@ -431,6 +555,10 @@ public:
                          const KDDockWidgets::InitialOption & = KDDockWidgets::DefaultSizeMode::Fair);
 
     void requestSeparatorMove(LayoutingSeparator *separator, int delta);
+
+    /// Removes nesting which became redundant after items were removed in bulk, via simplify().
+    /// Returns how many containers were removed. See Layout::compactPlaceholders()
+    int collapseRedundantContainers();
     int minPosForSeparator(LayoutingSeparator *, bool honourMax = true) const;
     int maxPosForSeparator(LayoutingSeparator *, bool honourMax = true) const;
     int minPosForSeparator_global(LayoutingSeparator *,
@@ -592,6 +720,7 @@ private:
 
     static bool s_inhibitSimplify;
     friend class Core::Item;
+    friend struct AtomicGeometryCommit;
     struct Private;
     Private *const d;
 };
@@ -624,6 +753,53 @@ struct AtomicSanityChecks
     KDDW_DELETE_COPY_CTOR(AtomicSanityChecks)
 };
 
+/// A layout pass can move the same item several times, and each move would reach the guest's view.
+/// While an AtomicGeometryCommit is alive, items and separators only record that their guest geometry
+/// is stale. When the outermost one goes out of scope, final geometries are applied once, in tree
+/// order. Item geometries themselves are still updated immediately.
+struct DOCKS_EXPORT AtomicGeometryCommit
+{
+    AtomicGeometryCommit();
+    ~AtomicGeometryCommit();
+
+    /// Returns whether geometries are currently being deferred
+    static bool isActive();
+
+private:
+    friend class Item;
+    friend class LayoutingSeparator;
+    /// An item or separator to apply, as an index into the list being committed
+    struct Entry
+    {
+        int index;
+        bool isSeparator;
+    };
+
+    static void commit();
+    /// Appends the pending items and separators of @p item's subtree which are in @p items or
+    /// @p separators. The others are pending for a nested commit.
+    static void collect_recursive(Item *item, const Vector<Item *> &items,
+                                  const Vector<LayoutingSeparator *> &separators, std::vector<Entry> &order);
+
+    /// Appends @p obj to @p list, leaving any list it was in. Used when pending geometry is recorded.
+    template<typename T>
+    static void addToList(T *obj, Vector<T *> &list);
+
+    /// Nulls @p obj's entry, so a commit in progress skips it. Used when it's deleted or recycled.
+    template<typename T>
+    static void removeFromList(T *obj);
+
+    /// Moves @p from into @p to, which commit() iterates. Layouting triggered by the guests then
+    /// starts a new list, instead of modifying the one being committed.
+    template<typename T>
+    static void takeList(Vector<T *> &from, Vector<T *> &to);
+
+    /// Called once commit() is done with @p list
+    template<typename T>
+    static void releaseList(Vector<T *> &list);
+    KDDW_DELETE_COPY_CTOR(AtomicGeometryCommit)
+};
+
 DOCKS_EXPORT void from_json(const nlohmann::json &, SizingInfo &);
 DOCKS_EXPORT void to_json(nlohmann::json &, const SizingInfo &);
 DOCKS_EXPORT void to_json(nlohmann::json &, Item *);
@@ -14,12 +14,16 @@
 #include "kddockwidgets/docks_export.h"
 #include "kddockwidgets/KDDockWidgets.h"
 
+#include <cstdint>
+
 namespace KDDockWidgets {
 
 namespace Core {
 
 class LayoutingGuest;
+class LayoutingSeparator;
 class ItemContainer;
+class ItemBoxContainer;
 
 /// The interface graphical components need to implement in order to host a layout
 /// The layout engine doesn't know about any GUI, only about LayoutingHost.
@@ -33,7 +37,7 @@ class ItemContainer;
 class DOCKS_EXPORT LayoutingHost
 {
 public:
-    LayoutingHost() = default;
+    LayoutingHost();
     virtual ~LayoutingHost();
 
     /// Weather this layout host supports min size constraints or not
@@ -45,9 +49,38 @@ public:
     void insertItemRelativeTo(Core::LayoutingGuest *guest, Core::LayoutingGuest *relativeTo, Location loc,
                               const InitialOption &initialOption = {});
 
+    /// Returns a value which changes whenever something that ends up in the serialized layout
+    /// changes: geometries, visibility, size constraints, insertions and removals.
+    /// Values are unique across hosts, so a stale value never matches a newer host at the same address.
+    uint64_t generation() const
+    {
+        return m_generation;
+    }
+
+    /// Called by the layouting engine, and by guests when their own serialized state changes
+    void markDirty();
+
+    /// Returns an unused separator with orientation @p o, now belonging to @p container.
+    /// Returns nullptr if there's none, in which case the caller creates a new one.
+    LayoutingSeparator *takeRecycledSeparator(Qt::Orientation o, Core::ItemBoxContainer *container);
+
+    /// Keeps @p separator for later reuse instead of deleting it.
+    /// Returns false if the pool is full, in which case the caller frees it.
+    bool recycleSeparator(LayoutingSeparator *separator);
+
+    /// Frees all recycled separators. Hosts call this before their view goes away,
+    /// as the separator views are children of it.
+    void clearRecycledSeparators();
+
+    /// Returns how many separators are waiting to be reused
+    int numRecycledSeparators() const;
+
     Core::ItemContainer *m_rootItem = nullptr;
 
 private:
+    uint64_t m_generation;
+    Vector<LayoutingSeparator *> m_recycledSeparators;
+
     LayoutingHost(const LayoutingHost &) = delete;
     LayoutingHost &operator=(const LayoutingHost &) = delete;
 };
@@ -21,6 +21,7 @@ namespace Core {
 
 class Separator;
 class LayoutingHost;
+struct AtomicGeometryCommit;
 class ItemBoxContainer;
 
 class DOCKS_EXPORT LayoutingSeparator
@@ -35,6 +36,17 @@ public:
     virtual void raise();
     virtual void free();
 
+    /// Called when the separator goes into its host's pool, see LayoutingHost::recycleSeparator()
+    /// Reimplement to hide the view.
+    virtual void onRecycled();
+
+    /// Called when the separator is taken out of the pool, before it gets its new geometry
+    virtual void onReused();
+
+    /// Returns the geometry the separator will have once the open AtomicGeometryCommit is applied,
+    /// or geometry() if there's nothing pending
+    Rect effectiveGeometry() const;
+
     int position() const;
     bool isVertical() const;
     ItemBoxContainer *parentContainer() const;
@@ -49,12 +61,21 @@ public:
 
     LayoutingHost *const m_host;
     const Qt::Orientation m_orientation;
-    Core::ItemBoxContainer *const m_parentContainer;
+    Core::ItemBoxContainer *m_parentContainer;
 
     static LayoutingSeparator *s_separatorBeingDragged;
 
 private:
+    friend struct AtomicGeometryCommit;
+    friend class LayoutingHost;
+    void discardPendingGeometry();
     int offset() const;
+    Rect m_pendingGeometry;
+    bool m_geometryPending = false;
+    /// The AtomicGeometryCommit list this separator is in, and where. Kept while being committed,
+    /// even after m_geometryPending is cleared, so the destructor can null the entry.
+    Vector<LayoutingSeparator *> *m_pendingGeometryList = nullptr;
+    int m_pendingGeometryIndex = -1;
     LayoutingSeparator(const LayoutingSeparator &) = delete;
     LayoutingSeparator &operator=(const LayoutingSeparator &) = delete;
 };
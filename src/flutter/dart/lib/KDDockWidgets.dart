@@ -14,6 +14,8 @@ library kddockwidgets;
 import 'package:KDDockWidgets/models/GeometryItem.dart';
 import 'package:KDDockWidgets/models/Separator.dart';
 import 'package:KDDockWidgets/private/Bindings.dart';
+import 'package:KDDockWidgets/private/LayoutChanges.dart';
+import 'package:KDDockWidgets/private/kddw_bindings.dart';
 import 'package:flutter/material.dart';
 
 import 'dart:ffi' as ffi;
@@ -47,6 +47,22 @@ void _separatorRemovedCallback(
   }
 }
 
+// Called from C++, once per layout pass
+void _layoutChangedCallback(
+    ffi.Pointer<ffi.Void> host,
+    ffi.Pointer<kddw_guest_geometry> guests,
+    int numGuests,
+    ffi.Pointer<kddw_separator_geometry> separators,
+    int numSeparators) {
+  try {
+    DropArea dropArea = _dropAreaInstances[host.address]!.target!;
+    dropArea._on_layout_changed_in_cpp(
+        LayoutChanges.decode(guests, numGuests, separators, numSeparators));
+  } catch (e) {
+    print('Error in _layoutChangedCallback: $e');
+  }
+}
+
 class DropArea implements ffi.Finalizable {
   static final _finalizer =
       ffi.NativeFinalizer(finalizerFunc("delete_host").cast());
@@ -76,6 +92,18 @@ class DropArea implements ffi.Finalizable {
     Bindings.instance.nativeLibrary.set_separator_removed_callback(
         _hostCpp.cast(), separatorRemovedCallbackPointer);
 
+    // Geometry changes arrive in one call per layout pass, instead of one per group and separator
+    final layoutChangedCallbackPointer = ffi.Pointer.fromFunction<
+        ffi.Void Function(
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<kddw_guest_geometry>,
+            ffi.Int,
+            ffi.Pointer<kddw_separator_geometry>,
+            ffi.Int)>(_layoutChangedCallback);
+
+    Bindings.instance.nativeLibrary.set_layout_changed_callback(
+        _hostCpp.cast(), layoutChangedCallbackPointer);
+
     _dropAreaInstances[_hostCpp.address] = WeakReference<DropArea>(this);
 
     // cleanup since we don't have dtors
@@ -172,6 +200,31 @@ class DropArea implements ffi.Finalizable {
     layoutChanged.emit();
   }
 
+  void _on_layout_changed_in_cpp(LayoutChanges changes) {
+    for (final change in changes.guests) {
+      // C++ might report a guest before Group's ctor registered it
+      final group = _instances[change.guestAddress]?.target ?? groupInCtor;
+      if (group == null) continue;
+
+      group.geometry = change.geometry;
+      group.isVisible = change.isVisible;
+      group.changed.emit();
+    }
+
+    if (changes.separators.isEmpty) return;
+
+    final separatorsByAddress = {
+      for (final sep in _separators) sep.separatorCpp.address: sep
+    };
+    for (final change in changes.separators) {
+      final sep = separatorsByAddress[change.separatorAddress];
+      if (sep == null) continue;
+
+      sep.geometry = change.geometry;
+      sep.changed.emit();
+    }
+  }
+
   ffi.Pointer<void> get hostPtr {
     return _hostCpp;
   }
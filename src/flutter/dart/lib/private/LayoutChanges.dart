@@ -0,0 +1,62 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+import 'dart:ffi' as ffi;
+import 'dart:ui';
+
+import 'package:KDDockWidgets/private/kddw_bindings.dart';
+
+/// A guest's new geometry, as reported by set_layout_changed_callback
+class GuestGeometry {
+  /// Address of the C++ guest, as returned by create_guest
+  final int guestAddress;
+  final Rect geometry;
+  final bool isVisible;
+
+  const GuestGeometry(this.guestAddress, this.geometry, this.isVisible);
+}
+
+/// A separator's new geometry, as reported by set_layout_changed_callback
+class SeparatorGeometry {
+  /// Address of the C++ separator, as passed to the separator added callback
+  final int separatorAddress;
+  final Rect geometry;
+
+  const SeparatorGeometry(this.separatorAddress, this.geometry);
+}
+
+/// Decodes the arrays C++ passes to the set_layout_changed_callback callback
+/// They're only valid during the callback, so everything is copied out.
+class LayoutChanges {
+  final List<GuestGeometry> guests;
+  final List<SeparatorGeometry> separators;
+
+  LayoutChanges.decode(
+      ffi.Pointer<kddw_guest_geometry> guestsCpp,
+      int numGuests,
+      ffi.Pointer<kddw_separator_geometry> separatorsCpp,
+      int numSeparators)
+      : guests = List.generate(numGuests, (i) {
+          final record = guestsCpp[i];
+          return GuestGeometry(
+              record.guest.address,
+              Rect.fromLTWH(record.x.toDouble(), record.y.toDouble(),
+                  record.width.toDouble(), record.height.toDouble()),
+              record.is_visible != 0);
+        }, growable: false),
+        separators = List.generate(numSeparators, (i) {
+          final record = separatorsCpp[i];
+          return SeparatorGeometry(
+              record.separator.address,
+              Rect.fromLTWH(record.x.toDouble(), record.y.toDouble(),
+                  record.width.toDouble(), record.height.toDouble()));
+        }, growable: false);
+}
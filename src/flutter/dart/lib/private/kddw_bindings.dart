@@ -330,4 +330,90 @@ class NativeLibrary {
                           ffi.Int y,
                           ffi.Int width,
                           ffi.Int height)>>)>();
+
+  /// Batched alternative to the per-guest and per-separator callbacks
+  /// When set, each call into the host (resize, insert, remove, separator drag) results in at most one
+  /// callback, carrying the guests and separators that changed, and the per-item callbacks aren't called.
+  /// Each guest and separator appears at most once. The arrays are only valid during the callback.
+  /// Separator additions and removals are still reported via their own callbacks, before this one.
+  void set_layout_changed_callback(
+    ffi.Pointer<ffi.Void> host,
+    ffi.Pointer<
+            ffi.NativeFunction<
+                ffi.Void Function(
+                    ffi.Pointer<ffi.Void> host,
+                    ffi.Pointer<kddw_guest_geometry> guests,
+                    ffi.Int num_guests,
+                    ffi.Pointer<kddw_separator_geometry> separators,
+                    ffi.Int num_separators)>>
+        callback,
+  ) {
+    return _set_layout_changed_callback(
+      host,
+      callback,
+    );
+  }
+
+  late final _set_layout_changed_callbackPtr = _lookup<
+          ffi.NativeFunction<
+              ffi.Void Function(
+                  ffi.Pointer<ffi.Void>,
+                  ffi.Pointer<
+                      ffi.NativeFunction<
+                          ffi.Void Function(
+                              ffi.Pointer<ffi.Void> host,
+                              ffi.Pointer<kddw_guest_geometry> guests,
+                              ffi.Int num_guests,
+                              ffi.Pointer<kddw_separator_geometry> separators,
+                              ffi.Int num_separators)>>)>>(
+      'set_layout_changed_callback');
+  late final _set_layout_changed_callback =
+      _set_layout_changed_callbackPtr.asFunction<
+          void Function(
+              ffi.Pointer<ffi.Void>,
+              ffi.Pointer<
+                  ffi.NativeFunction<
+                      ffi.Void Function(
+                          ffi.Pointer<ffi.Void> host,
+                          ffi.Pointer<kddw_guest_geometry> guests,
+                          ffi.Int num_guests,
+                          ffi.Pointer<kddw_separator_geometry> separators,
+                          ffi.Int num_separators)>>)>();
+}
+
+/// A guest's new geometry and visibility, see set_layout_changed_callback()
+final class kddw_guest_geometry extends ffi.Struct {
+  external ffi.Pointer<ffi.Void> guest;
+
+  @ffi.Int()
+  external int x;
+
+  @ffi.Int()
+  external int y;
+
+  @ffi.Int()
+  external int width;
+
+  @ffi.Int()
+  external int height;
+
+  @ffi.Int()
+  external int is_visible;
+}
+
+/// A separator's new geometry, see set_layout_changed_callback()
+final class kddw_separator_geometry extends ffi.Struct {
+  external ffi.Pointer<ffi.Void> separator;
+
+  @ffi.Int()
+  external int x;
+
+  @ffi.Int()
+  external int y;
+
+  @ffi.Int()
+  external int width;
+
+  @ffi.Int()
+  external int height;
 }
@@ -0,0 +1,63 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+import 'dart:ffi' as ffi;
+import 'dart:ui';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:KDDockWidgets/private/LayoutChanges.dart';
+import 'package:KDDockWidgets/private/kddw_bindings.dart';
+
+void main() {
+  test('decode', () {
+    final guests = calloc<kddw_guest_geometry>(2);
+    final separators = calloc<kddw_separator_geometry>(1);
+
+    guests[0].guest = ffi.Pointer.fromAddress(0x1000);
+    guests[0].x = 0;
+    guests[0].y = 0;
+    guests[0].width = 100;
+    guests[0].height = 200;
+    guests[0].is_visible = 1;
+    guests[1].guest = ffi.Pointer.fromAddress(0x2000);
+    guests[1].x = 105;
+    guests[1].width = 50;
+    guests[1].height = 200;
+    guests[1].is_visible = 0;
+    separators[0].separator = ffi.Pointer.fromAddress(0x3000);
+    separators[0].x = 100;
+    separators[0].width = 5;
+    separators[0].height = 200;
+
+    final changes = LayoutChanges.decode(guests, 2, separators, 1);
+    calloc.free(guests);
+    calloc.free(separators);
+
+    expect(changes.guests.length, 2);
+    expect(changes.guests[0].guestAddress, 0x1000);
+    expect(changes.guests[0].geometry, Rect.fromLTWH(0, 0, 100, 200));
+    expect(changes.guests[0].isVisible, true);
+    expect(changes.guests[1].guestAddress, 0x2000);
+    expect(changes.guests[1].geometry, Rect.fromLTWH(105, 0, 50, 200));
+    expect(changes.guests[1].isVisible, false);
+
+    expect(changes.separators.length, 1);
+    expect(changes.separators[0].separatorAddress, 0x3000);
+    expect(changes.separators[0].geometry, Rect.fromLTWH(100, 0, 5, 200));
+  });
+
+  test('empty', () {
+    final changes = LayoutChanges.decode(ffi.nullptr, 0, ffi.nullptr, 0);
+    expect(changes.guests, isEmpty);
+    expect(changes.separators, isEmpty);
+  });
+}
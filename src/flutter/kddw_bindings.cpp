@@ -22,11 +22,13 @@
 #include <utility>
 #include <iostream>
 #include <mutex>
+#include <vector>
 
 using namespace KDDockWidgets;
 
 namespace {
 
+class Guest;
 class Separator;
 class Host : public KDDockWidgets::Core::LayoutingHost
 {
@@ -43,8 +45,52 @@ public:
         return true;
     }
 
+    bool isBatching() const
+    {
+        return _layout_changed_callback != nullptr;
+    }
+
+    /// Records that @p guest changed, replacing any previous record of it
+    void addPendingGuest(Guest *guest);
+    void addPendingSeparator(Separator *separator);
+
+    /// For when they're deleted before the flush
+    void removePendingGuest(Guest *guest);
+    void removePendingSeparator(Separator *separator);
+
+    /// Calls _layout_changed_callback with what changed, if anything
+    void flush();
+
     void (*_separator_added_callback)(void *host, void *separator, int isVertical) = nullptr;
     void (*_separator_removed_callback)(void *host, void *separator) = nullptr;
+    void (*_layout_changed_callback)(void *host, const kddw_guest_geometry *guests, int num_guests,
+                                     const kddw_separator_geometry *separators, int num_separators) = nullptr;
+
+    /// Nesting level of BatchScope
+    int _batchDepth = 0;
+    std::vector<kddw_guest_geometry> _pendingGuests;
+    std::vector<kddw_separator_geometry> _pendingSeparators;
+};
+
+/// Wraps each entry point, so everything the layout pass changes is sent to Flutter in one go
+struct BatchScope
+{
+    explicit BatchScope(Host *host)
+        : _host(host)
+    {
+        _host->_batchDepth++;
+    }
+
+    ~BatchScope()
+    {
+        _host->_batchDepth--;
+        if (_host->_batchDepth == 0)
+            _host->flush();
+    }
+
+    Host *const _host;
+    BatchScope(const BatchScope &) = delete;
+    BatchScope &operator=(const BatchScope &) = delete;
 };
 
 class Guest : public KDDockWidgets::Core::LayoutingGuest
@@ -54,11 +100,17 @@ public:
     explicit Guest(Host *host, void (*callback)(void *guest, int x, int y, int width, int height, int is_visible))
         : _item(new Core::Item(host))
         , _uniqueName(QString::fromStdString("id=" + std::to_string(s_nextId)))
+        , _host(host)
         , _changed_callback(callback)
     {
         _item->setGuest(this);
     }
 
+    ~Guest() override
+    {
+        _host->removePendingGuest(this);
+    }
+
     Size minSize() const override
     {
         return { 100, 100 };
@@ -112,6 +164,11 @@ public:
 
     void tellFlutter()
     {
+        if (_host->isBatching()) {
+            _host->addPendingGuest(this);
+            return;
+        }
+
         assert(_changed_callback);
         _changed_callback(this, _geometry.x(), _geometry.y(), _geometry.width(), _geometry.height(), _isVisible ? 1 : 0);
     }
@@ -121,6 +178,10 @@ public:
     QString _uniqueName;
     Rect _geometry;
     bool _isVisible = false;
+    Host *const _host;
+
+    /// Index into Host::_pendingGuests, -1 if not there
+    int _pendingIndex = -1;
 
     void (*_changed_callback)(void *guest_, int x, int y, int width, int height, int is_visible) = nullptr;
 };
@@ -141,9 +202,26 @@ public:
 
     ~Separator() override
     {
+        _host->removePendingSeparator(this);
+        if (!_isRecycled)
+            _host->_separator_removed_callback(_host, this);
+    }
+
+    void onRecycled() override
+    {
+        // Flutter drops its widget, it's added again if reused
+        _isRecycled = true;
+        _geo = {};
+        _host->removePendingSeparator(this);
         _host->_separator_removed_callback(_host, this);
     }
 
+    void onReused() override
+    {
+        _isRecycled = false;
+        _host->_separator_added_callback(_host, this, isVertical() ? 1 : 0);
+    }
+
     Rect
     geometry() const override
     {
@@ -161,13 +239,22 @@ public:
 
     void tellFlutter()
     {
+        if (_host->isBatching()) {
+            _host->addPendingSeparator(this);
+            return;
+        }
+
         assert(_changed_callback);
         _changed_callback(this, _geo.x(), _geo.y(), _geo.width(), _geo.height());
     }
 
     Rect _geo;
     int _id = 0;
+    bool _isRecycled = false;
     Host *const _host;
+
+    /// Index into Host::_pendingSeparators, -1 if not there
+    int _pendingIndex = -1;
     void (*_changed_callback)(void *separator, int x, int y, int width, int height) = nullptr;
 };
 }
@@ -194,15 +281,94 @@ Host::~Host()
 {
 }
 
+void Host::addPendingGuest(Guest *guest)
+{
+    const Rect geo = guest->_geometry;
+    const kddw_guest_geometry record = { guest, geo.x(), geo.y(), geo.width(), geo.height(), guest->_isVisible ? 1 : 0 };
+
+    if (guest->_pendingIndex == -1) {
+        guest->_pendingIndex = int(_pendingGuests.size());
+        _pendingGuests.push_back(record);
+    } else {
+        _pendingGuests[size_t(guest->_pendingIndex)] = record;
+    }
+
+    // Changes outside of any entry point are sent right away
+    if (_batchDepth == 0)
+        flush();
+}
+
+void Host::addPendingSeparator(Separator *separator)
+{
+    const Rect geo = separator->_geo;
+    const kddw_separator_geometry record = { separator, geo.x(), geo.y(), geo.width(), geo.height() };
+
+    if (separator->_pendingIndex == -1) {
+        separator->_pendingIndex = int(_pendingSeparators.size());
+        _pendingSeparators.push_back(record);
+    } else {
+        _pendingSeparators[size_t(separator->_pendingIndex)] = record;
+    }
+
+    if (_batchDepth == 0)
+        flush();
+}
+
+void Host::removePendingGuest(Guest *guest)
+{
+    if (guest->_pendingIndex == -1)
+        return;
+
+    // Swap with the last one, order doesn't matter
+    const auto index = size_t(guest->_pendingIndex);
+    _pendingGuests[index] = _pendingGuests.back();
+    static_cast<Guest *>(_pendingGuests[index].guest)->_pendingIndex = int(index);
+    _pendingGuests.pop_back();
+    guest->_pendingIndex = -1;
+}
+
+void Host::removePendingSeparator(Separator *separator)
+{
+    if (separator->_pendingIndex == -1)
+        return;
+
+    const auto index = size_t(separator->_pendingIndex);
+    _pendingSeparators[index] = _pendingSeparators.back();
+    static_cast<Separator *>(_pendingSeparators[index].separator)->_pendingIndex = int(index);
+    _pendingSeparators.pop_back();
+    separator->_pendingIndex = -1;
+}
+
+void Host::flush()
+{
+    if (!_layout_changed_callback || (_pendingGuests.empty() && _pendingSeparators.empty()))
+        return;
+
+    // Flutter might call back into us, so take them out first
+    const std::vector<kddw_guest_geometry> guests = std::move(_pendingGuests);
+    const std::vector<kddw_separator_geometry> separators = std::move(_pendingSeparators);
+    _pendingGuests.clear();
+    _pendingSeparators.clear();
+
+    for (const kddw_guest_geometry &record : guests)
+        static_cast<Guest *>(record.guest)->_pendingIndex = -1;
+    for (const kddw_separator_geometry &record : separators)
+        static_cast<Separator *>(record.separator)->_pendingIndex = -1;
+
+    _layout_changed_callback(this, guests.data(), int(guests.size()), separators.data(), int(separators.size()));
+}
+
 void on_flutter_droparea_widget_resized(void *host_, int width, int height)
 {
     auto host = reinterpret_cast<Host *>(host_);
+    BatchScope batch(host);
     host->onFlutterWindowResized(width, height);
 }
 
 void on_separator_mouse_button_event(void *separator_, int pressed)
 {
     auto separator = reinterpret_cast<Separator *>(separator_);
+    BatchScope batch(separator->_host);
     if (pressed == 1) {
         separator->onMousePress();
     } else {
@@ -213,6 +379,7 @@ void on_separator_mouse_button_event(void *separator_, int pressed)
 void on_separator_mouse_move_event(void *separator_, float x, float y)
 {
     auto separator = reinterpret_cast<Separator *>(separator_);
+    BatchScope batch(separator->_host);
     if (separator->isVertical()) {
         const int oldPos = separator->position();
         separator->onMouseMove({ 0, oldPos + int(y) });
@@ -234,7 +401,9 @@ void delete_host(void *host)
 
 void *create_guest(void *host, void (*callback)(void *guest, int x, int y, int width, int height, int is_visible))
 {
-    return new Guest(reinterpret_cast<Host *>(host), callback);
+    auto h = reinterpret_cast<Host *>(host);
+    BatchScope batch(h);
+    return new Guest(h, callback);
 }
 
 void delete_guest(void *guest)
@@ -267,6 +436,7 @@ void insert_item(void *_host, void *_guest, int _location)
     assert(host);
     assert(guest);
 
+    BatchScope batch(host);
     host->insertItem(guest, location);
 }
 
@@ -281,6 +451,7 @@ void insert_item_relative_to(void *host_, void *guest_, void *relativeToGuest_,
     assert(host);
     assert(guest);
     assert(relativeToGuest);
+    BatchScope batch(host);
     host->insertItemRelativeTo(guest, relativeToGuest, location);
 }
 
@@ -309,6 +480,7 @@ void remove_guest(void *host_, void *guest_)
     auto host = reinterpret_cast<Host *>(host_);
     auto guest = reinterpret_cast<Guest *>(guest_);
 
+    BatchScope batch(host);
     host->m_rootItem->removeItem(guest->_item);
 }
 
@@ -327,3 +499,10 @@ void set_separator_removed_callback(void *host_, void (*callback)(void *host, vo
     assert(host->_separator_removed_callback == nullptr);
     host->_separator_removed_callback = callback;
 }
+
+void set_layout_changed_callback(void *host_, void (*callback)(void *host, const kddw_guest_geometry *guests, int num_guests, const kddw_separator_geometry *separators, int num_separators))
+{
+    assert(host_);
+    auto host = reinterpret_cast<Host *>(host_);
+    host->_layout_changed_callback = callback;
+}
@@ -35,6 +35,34 @@ DOCKS_EXPORT void set_separator_added_callback(void *host, void (*callback)(void
 DOCKS_EXPORT void set_separator_removed_callback(void *host, void (*callback)(void *host, void *separator));
 DOCKS_EXPORT void set_separator_changed_callback(void *separator, void (*callback)(void *separator, int x, int y, int width, int height));
 
+/// A guest's new geometry and visibility, see set_layout_changed_callback()
+typedef struct
+{
+    void *guest;
+    int x;
+    int y;
+    int width;
+    int height;
+    int is_visible;
+} kddw_guest_geometry;
+
+/// A separator's new geometry, see set_layout_changed_callback()
+typedef struct
+{
+    void *separator;
+    int x;
+    int y;
+    int width;
+    int height;
+} kddw_separator_geometry;
+
+/// Batched alternative to the per-guest and per-separator callbacks
+/// When set, each call into the host (resize, insert, remove, separator drag) results in at most one
+/// callback, carrying the guests and separators that changed, and the per-item callbacks aren't called.
+/// Each guest and separator appears at most once. The arrays are only valid during the callback.
+/// Separator additions and removals are still reported via their own callbacks, before this one.
+DOCKS_EXPORT void set_layout_changed_callback(void *host, void (*callback)(void *host, const kddw_guest_geometry *guests, int num_guests, const kddw_separator_geometry *separators, int num_separators));
+
 #ifdef __cplusplus
 }
 #endif
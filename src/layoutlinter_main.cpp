@@ -14,18 +14,36 @@
 
 #include "core/MainWindow.h"
 #include "core/DockWidget.h"
+#include "core/DockRegistry.h"
+#include "core/Layout.h"
 #include "core/Platform.h"
+#include "core/MemoryReport.h"
+#include "core/FloatingWindow.h"
+#include "core/LayoutSaver_p.h"
 
 #include <QDebug>
 #include <QString>
 #include <QApplication>
 #include <QCommandLineParser>
 #include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QEventLoop>
 #include <QFileInfo>
+#include <QProcess>
+#include <QThread>
 #include <QTimer>
 
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <utility>
+
 using namespace KDDockWidgets;
 using namespace KDDockWidgets::Core;
 
@@ -95,12 +113,8 @@ LinterConfig requestedLinterConfig(const QCommandLineParser &parser, const QStri
     return c;
 }
 
-static bool lint(const QString &filename, LinterConfig config, bool isVerbose)
+static void setUpFactories()
 {
-    if (isVerbose) {
-        qDebug() << "Linting" << filename << "with options" << config.restoreOptions;
-    }
-
     DockWidgetFactoryFunc dwFunc = [](const QString &dwName) {
         return Config::self().viewFactory()->createDockWidget(dwName)->asDockWidgetController();
     };
@@ -112,8 +126,11 @@ static bool lint(const QString &filename, LinterConfig config, bool isVerbose)
 
     KDDockWidgets::Config::self().setDockWidgetFactoryFunc(dwFunc);
     KDDockWidgets::Config::self().setMainWindowFactoryFunc(mwFunc);
+}
 
-    // Create the main windows specified from -c <file>
+/// Creates the main windows specified from -c <file>
+static void createMainWindows(const LinterConfig &config, bool isVerbose)
+{
     for (auto mw : config.mainWindows) {
         const QString name = QString::fromStdString(mw.name);
         if (isVerbose)
@@ -125,11 +142,397 @@ static bool lint(const QString &filename, LinterConfig config, bool isVerbose)
         else
             mainWindow->view()->show();
     }
+}
+
+static bool lint(const QString &filename, LinterConfig config, bool isVerbose, bool memoryReport)
+{
+    if (isVerbose) {
+        qDebug() << "Linting" << filename << "with options" << config.restoreOptions;
+    }
+
+    setUpFactories();
+    createMainWindows(config, isVerbose);
 
     LayoutSaver restorer(config.restoreOptions);
-    return restorer.restoreFromFile(filename);
+    const bool success = restorer.restoreFromFile(filename);
+
+    if (memoryReport) {
+        // Placeholders the restore left behind show up as leaks here
+        qDebug().noquote() << "Memory report for" << filename << "\n"
+                           << Core::MemoryReport::collect().toString();
+    }
+
+    return success;
+}
+
+/// Returns whether @p filename looks like a layout, either JSON or binary
+static bool isLayoutFile(const QString &filename)
+{
+    if (filename.endsWith(QLatin1String(".json"), Qt::CaseInsensitive))
+        return true;
+
+    // Binary layouts have no conventional extension, check the CBOR tag instead
+    QFile f(filename);
+    return f.open(QIODevice::ReadOnly) && LayoutSaver::Layout::isBinary(f.read(16));
 }
 
+/// Replaces directories in @p files with the layouts they contain, recursively
+static std::vector<std::string> expandDirectories(const std::vector<std::string> &files)
+{
+    std::vector<std::string> result;
+    for (const std::string &file : files) {
+        const QString path = QString::fromStdString(file);
+        if (!QFileInfo(path).isDir()) {
+            result.push_back(file);
+            continue;
+        }
+
+        QStringList layouts;
+        QDirIterator it(path, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const QString candidate = it.next();
+            if (isLayoutFile(candidate))
+                layouts.push_back(candidate);
+        }
+
+        // So the output doesn't depend on the file system's order
+        layouts.sort();
+        for (const QString &layout : std::as_const(layouts))
+            result.push_back(layout.toStdString());
+    }
+
+    return result;
+}
+
+/// Batch mode protocol. A worker reads one layout path per line from stdin and, for each one,
+/// prints a begin line, then a result line with a JSON object. Anything printed in between,
+/// including KDDW's own warnings, belongs to that layout.
+static const char s_beginMarker[] = "@kddw-linter-begin ";
+static const char s_resultMarker[] = "@kddw-linter-result ";
+
+/// Restores @p filename and returns its result, for batch mode
+static nlohmann::json lintForBatch(const QString &filename, const LinterConfig &config)
+{
+    QElapsedTimer timer;
+    timer.start();
+    LayoutSaver restorer(config.restoreOptions);
+    const bool restored = restorer.restoreFromFile(filename);
+    const double restoreMs = double(timer.nsecsElapsed()) / 1000000.0;
+
+    DockRegistry *registry = DockRegistry::self();
+    bool sane = true;
+    int numItems = 0;
+    int numPlaceholders = 0;
+    for (Core::Layout *layout : registry->layouts()) {
+        sane = layout->checkSanity() && sane;
+        numItems += layout->count();
+        numPlaceholders += layout->placeholderCount();
+    }
+
+    nlohmann::json result;
+    result["file"] = filename.toStdString();
+    result["pass"] = restored && sane;
+    result["restored"] = restored;
+    result["sane"] = sane;
+    result["restoreMs"] = restoreMs;
+    result["counts"] = {
+        { "mainWindows", registry->mainwindows().size() },
+        { "floatingWindows", registry->floatingWindows().size() },
+        { "dockWidgets", registry->dockwidgets().size() },
+        { "groups", registry->groups().size() },
+        { "items", numItems },
+        { "placeholders", numPlaceholders },
+    };
+
+    return result;
+}
+
+/// Deletes what the factories created while restoring the last file. Main windows from -c <file>
+/// are kept, but emptied.
+static void resetForNextFile(const LinterConfig &config)
+{
+    DockRegistry *registry = DockRegistry::self();
+    registry->clear();
+
+    for (Core::DockWidget *dw : registry->dockwidgets())
+        dw->destroyLater();
+
+    for (Core::FloatingWindow *fw : registry->floatingWindows())
+        fw->destroyLater();
+
+    for (Core::MainWindow *mw : registry->mainwindows()) {
+        const std::string name = mw->uniqueName().toStdString();
+        const bool isFromConfig = std::any_of(config.mainWindows.cbegin(), config.mainWindows.cend(),
+                                              [&name](const LinterConfig::MainWindow &configMw) {
+                                                  return configMw.name == name;
+                                              });
+        if (!isFromConfig)
+            mw->destroyLater();
+    }
+
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QCoreApplication::processEvents();
+}
+
+/// The worker side of batch mode, see BatchLinter
+static int runWorker(const LinterConfig &config)
+{
+    setUpFactories();
+    createMainWindows(config, /*isVerbose=*/false);
+
+    std::string file;
+    while (std::getline(std::cin, file)) {
+        if (file.empty())
+            continue;
+
+        // Warnings go to stderr, which is merged with stdout. Flush so they end up in order.
+        std::printf("%s%s\n", s_beginMarker, file.c_str());
+        std::fflush(stdout);
+
+        const nlohmann::json result = lintForBatch(QString::fromStdString(file), config);
+        std::fflush(stderr);
+        std::printf("%s%s\n", s_resultMarker, result.dump().c_str());
+        std::fflush(stdout);
+
+        // Start the next file from a clean slate, otherwise it would restore into the dock widgets
+        // and main windows of this one, and be counted with them
+        resetForNextFile(config);
+    }
+
+    return 0;
+}
+
+/// Lints many files with a pool of worker processes, each running this executable with --worker
+/// and the offscreen platform.
+/// Files are handed out one at a time, so slow layouts don't hold back the rest.
+/// A worker that crashes or times out only fails the file it was on, and is replaced.
+/// Workers are also replaced after a number of files, so state doesn't pile up in the DockRegistry.
+class BatchLinter
+{
+public:
+    struct Options
+    {
+        int numJobs = 1;
+        int filesPerWorker = 200;
+        int timeoutMs = 60000;
+        QStringList workerArguments;
+    };
+
+    BatchLinter(const std::vector<std::string> &files, const Options &options)
+        : m_options(options)
+        , m_results(files.size())
+    {
+        for (size_t i = 0; i < files.size(); ++i) {
+            m_files.push_back(QFileInfo(QString::fromStdString(files[i])).absoluteFilePath());
+            m_pending.push_back(int(i));
+        }
+    }
+
+    /// Lints all files, blocking until done. Returns the report, with a result per file in the same order
+    nlohmann::json run()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        const int numWorkers = std::min(m_options.numJobs, int(m_files.size()));
+        for (int i = 0; i < numWorkers; ++i)
+            startWorker();
+
+        if (!m_workers.empty())
+            m_loop.exec();
+
+        int numPassed = 0;
+        nlohmann::json results = nlohmann::json::array();
+        for (nlohmann::json &result : m_results) {
+            if (result.is_object() && result.value("pass", false))
+                ++numPassed;
+            results.push_back(std::move(result));
+        }
+
+        nlohmann::json report;
+        report["summary"] = {
+            { "files", int(m_files.size()) },
+            { "passed", numPassed },
+            { "failed", int(m_files.size()) - numPassed },
+            { "jobs", numWorkers },
+            { "elapsedMs", timer.elapsed() },
+        };
+        report["results"] = std::move(results);
+
+        return report;
+    }
+
+private:
+    struct Worker
+    {
+        std::unique_ptr<QProcess> process;
+        std::unique_ptr<QTimer> timeout;
+        QByteArray buffer;
+        std::vector<std::string> log;
+        int currentFile = -1;
+        int numFiles = 0;
+        bool exiting = false;
+    };
+
+    void startWorker()
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->process = std::make_unique<QProcess>();
+        worker->timeout = std::make_unique<QTimer>();
+        worker->timeout->setSingleShot(true);
+
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.insert(QStringLiteral("QT_QPA_PLATFORM"), QStringLiteral("offscreen"));
+        worker->process->setProcessEnvironment(env);
+        worker->process->setProcessChannelMode(QProcess::MergedChannels);
+
+        Worker *w = worker.get();
+        QObject::connect(worker->process.get(), &QProcess::readyReadStandardOutput, [this, w] {
+            onOutput(w);
+        });
+        QObject::connect(worker->process.get(), QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                         [this, w] { onFinished(w); });
+        QObject::connect(worker->timeout.get(), &QTimer::timeout, [this, w] {
+            setResult(w, errorResult(w, "timeout"));
+            w->exiting = true;
+            w->process->kill();
+        });
+
+        m_workers.push_back(std::move(worker));
+        w->process->start(QCoreApplication::applicationFilePath(), m_options.workerArguments);
+        if (!w->process->waitForStarted()) {
+            qWarning() << "Failed to start linter worker:" << w->process->errorString();
+            m_workers.pop_back();
+            if (m_workers.empty()) {
+                // Nobody left to lint the rest
+                failPending("failed to start worker");
+                m_loop.quit();
+            }
+            return;
+        }
+
+        feed(w);
+    }
+
+    /// Gives @p w the next file, or tells it to exit if there's none or it did enough already
+    void feed(Worker *w)
+    {
+        if (w->exiting)
+            return;
+
+        if (m_pending.empty() || w->numFiles >= m_options.filesPerWorker) {
+            w->exiting = true;
+            w->process->closeWriteChannel();
+            return;
+        }
+
+        w->currentFile = m_pending.front();
+        m_pending.pop_front();
+        ++w->numFiles;
+        w->log.clear();
+
+        w->process->write(m_files.at(w->currentFile).toUtf8() + '\n');
+        if (m_options.timeoutMs > 0)
+            w->timeout->start(m_options.timeoutMs);
+    }
+
+    void onOutput(Worker *w)
+    {
+        w->buffer += w->process->readAllStandardOutput();
+
+        int newLine;
+        while ((newLine = w->buffer.indexOf('\n')) != -1) {
+            const QByteArray line = w->buffer.left(newLine).trimmed();
+            w->buffer.remove(0, newLine + 1);
+
+            if (line.startsWith(s_beginMarker)) {
+                w->log.clear();
+            } else if (line.startsWith(s_resultMarker)) {
+                if (w->currentFile == -1) {
+                    // Late output from a worker that timed out
+                    continue;
+                }
+
+                nlohmann::json result = nlohmann::json::parse(line.mid(int(sizeof(s_resultMarker)) - 1).toStdString(),
+                                                              nullptr, /*allow_exceptions=*/false);
+                if (result.is_discarded())
+                    result = errorResult(w, "invalid worker output");
+
+                setResult(w, std::move(result));
+                feed(w);
+            } else if (!line.isEmpty() && w->currentFile != -1) {
+                w->log.push_back(line.toStdString());
+            }
+        }
+    }
+
+    void onFinished(Worker *w)
+    {
+        w->exiting = true;
+        onOutput(w);
+
+        // Exiting while on a file means it crashed, or asserted
+        if (w->currentFile != -1)
+            setResult(w, errorResult(w, "crashed"));
+
+        w->process->disconnect();
+        w->timeout->disconnect();
+
+        // We're in one of its signals, so it can't be deleted right away
+        w->process.release()->deleteLater();
+
+        m_workers.erase(std::find_if(m_workers.begin(), m_workers.end(), [w](const auto &worker) {
+            return worker.get() == w;
+        }));
+
+        if (!m_pending.empty())
+            startWorker();
+
+        if (m_workers.empty())
+            m_loop.quit();
+    }
+
+    void setResult(Worker *w, nlohmann::json result)
+    {
+        if (w->currentFile == -1)
+            return;
+
+        w->timeout->stop();
+        result["warnings"] = w->log;
+        m_results[size_t(w->currentFile)] = std::move(result);
+        w->currentFile = -1;
+    }
+
+    nlohmann::json errorResult(Worker *w, const char *error) const
+    {
+        nlohmann::json result;
+        result["file"] = m_files.at(w->currentFile).toStdString();
+        result["pass"] = false;
+        result["error"] = error;
+        return result;
+    }
+
+    void failPending(const char *error)
+    {
+        for (int index : m_pending) {
+            nlohmann::json result;
+            result["file"] = m_files.at(index).toStdString();
+            result["pass"] = false;
+            result["error"] = error;
+            m_results[size_t(index)] = std::move(result);
+        }
+
+        m_pending.clear();
+    }
+
+    const Options m_options;
+    QStringList m_files;
+    std::deque<int> m_pending;
+    std::vector<nlohmann::json> m_results;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    QEventLoop m_loop;
+};
+
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
@@ -147,12 +550,25 @@ int main(int argc, char *argv[])
     QCommandLineOption verboseOpt = { { "v", "verbose" }, "Verbose output" };
     QCommandLineOption strictOpt = { { "s", "strict" }, "Strict mode" };
     QCommandLineOption waitAtEndOpt = { { "w", "wait" }, "Waits instead of exiting. For debugging purposes." };
+    QCommandLineOption memoryReportOpt = { { "m", "memory-report" }, "Prints object counts and estimated memory usage after each restore" };
+    QCommandLineOption jobsOpt = { { "j", "jobs" }, "Batch mode. Lints with this many worker processes and prints JSON results. 0 for one per CPU core.", "jobs" };
+    QCommandLineOption outputOpt = { { "o", "output" }, "Batch mode. Writes the JSON results into this file instead of stdout.", "file" };
+    QCommandLineOption filesPerWorkerOpt = { "files-per-worker", "Batch mode. Restarts workers after this many files. Default is 200.", "count", "200" };
+    QCommandLineOption timeoutOpt = { "timeout", "Batch mode. Fails files that take longer than this many milliseconds. Default is 60000.", "ms", "60000" };
+    QCommandLineOption workerOpt = { "worker", "Internal. Lints the files read from stdin, for batch mode." };
+    workerOpt.setFlags(QCommandLineOption::HiddenFromHelp);
 
     parser.addOption(configFileOpt);
     parser.addOption(verboseOpt);
     parser.addOption(waitAtEndOpt);
     parser.addOption(strictOpt);
-    parser.addPositionalArgument("layout", "layout json file");
+    parser.addOption(memoryReportOpt);
+    parser.addOption(jobsOpt);
+    parser.addOption(outputOpt);
+    parser.addOption(filesPerWorkerOpt);
+    parser.addOption(timeoutOpt);
+    parser.addOption(workerOpt);
+    parser.addPositionalArgument("layout", "layout file, either JSON or binary. In batch mode directories are searched for layouts: *.json files and binary layouts with any extension.");
     parser.addHelpOption();
 
     FrontendType frontendType = FrontendType::QtWidgets;
@@ -178,15 +594,63 @@ int main(int argc, char *argv[])
     KDDockWidgets::Config::self().setLayoutSaverStrictMode(parser.isSet(strictOpt));
 
     s_isVerbose = parser.isSet(verboseOpt);
-    const LinterConfig lc = requestedLinterConfig(parser, parser.isSet(configFileOpt) ? parser.value(configFileOpt) : QString());
+
+    // Absolute, as reading it changes the current directory, and workers need it too
+    const QString configFile = parser.isSet(configFileOpt) ? QFileInfo(parser.value(configFileOpt)).absoluteFilePath() : QString();
+
+    if (parser.isSet(workerOpt)) {
+        // The files come from stdin
+        return runWorker(configFile.isEmpty() ? LinterConfig() : requestedLinterConfig(parser, configFile));
+    }
+
+    LinterConfig lc = requestedLinterConfig(parser, configFile);
+    const bool isBatchMode = parser.isSet(jobsOpt);
+    if (isBatchMode)
+        lc.filesToLint = expandDirectories(lc.filesToLint);
+
     if (lc.isEmpty()) {
         qWarning() << "Bailing out";
         return 3;
     }
 
+    if (isBatchMode) {
+        BatchLinter::Options options;
+        options.numJobs = parser.value(jobsOpt).toInt();
+        if (options.numJobs <= 0)
+            options.numJobs = std::max(1, QThread::idealThreadCount());
+        options.filesPerWorker = std::max(1, parser.value(filesPerWorkerOpt).toInt());
+        options.timeoutMs = parser.value(timeoutOpt).toInt();
+
+        options.workerArguments = { QStringLiteral("--worker") };
+        if (!configFile.isEmpty())
+            options.workerArguments << QStringLiteral("--config") << configFile;
+        if (parser.isSet(strictOpt))
+            options.workerArguments << QStringLiteral("--strict");
+#if defined(KDDW_FRONTEND_QTQUICK) && defined(KDDW_FRONTEND_QTWIDGETS)
+        if (parser.isSet(forceQtQuick))
+            options.workerArguments << QStringLiteral("--force-qtquick");
+#endif
+
+        const nlohmann::json report = BatchLinter(lc.filesToLint, options).run();
+        const std::string json = report.dump(2);
+
+        if (parser.isSet(outputOpt)) {
+            std::ofstream file(parser.value(outputOpt).toStdString(), std::ios::binary);
+            if (!file.is_open()) {
+                qWarning() << "Failed to open" << parser.value(outputOpt);
+                return 3;
+            }
+            file << json << "\n";
+        } else {
+            std::cout << json << std::endl;
+        }
+
+        return report["summary"]["failed"].get<int>() == 0 ? 0 : 2;
+    }
+
     int exitCode = 0;
     for (const std::string &layout : lc.filesToLint) {
-        if (!lint(QString::fromStdString(layout), lc, s_isVerbose))
+        if (!lint(QString::fromStdString(layout), lc, s_isVerbose, parser.isSet(memoryReportOpt)))
             exitCode = 2;
     }
 
@@ -11,6 +11,7 @@
 
 #include "DragControllerWayland_p.h"
 #include "core/Logging_p.h"
+#include "core/Profiler_p.h"
 #include "core/ScopedValueRollback_p.h"
 #include "kddockwidgets/core/Platform.h"
 #include "kddockwidgets/core/DropArea.h"
@@ -28,6 +29,7 @@ StateDraggingWayland::~StateDraggingWayland()
 
 void StateDraggingWayland::onEntry()
 {
+    KDDW_PROFILE_SCOPE("DragController::StateDraggingWayland::onEntry");
     KDDW_DEBUG("StateDraggingWayland entered");
 
     if (DragController::instance()->m_inQDrag) {
@@ -59,6 +59,11 @@ QRect Screen_qt::virtualGeometry() const
     return m_screen->virtualGeometry();
 }
 
+double Screen_qt::refreshRate() const
+{
+    return m_screen ? m_screen->refreshRate() : Screen::refreshRate();
+}
+
 QScreen *Screen_qt::qtScreen() const
 {
     return m_screen;
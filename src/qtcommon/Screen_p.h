@@ -43,6 +43,8 @@ public:
 
     bool equals(std::shared_ptr<Screen> other) const override;
 
+    double refreshRate() const override;
+
 public:
     QPointer<QScreen> m_screen;
     Q_DISABLE_COPY(Screen_qt)
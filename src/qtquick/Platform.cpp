@@ -17,6 +17,7 @@
 #include "QmlTypes.h"
 
 #include "Helpers_p.h"
+#include "QmlComponentCache_p.h"
 #include "Window_p.h"
 #include "views/View.h"
 #include "qtquick/Window_p.h"
@@ -185,6 +186,21 @@ void Platform::setQmlEngine(QQmlEngine *qmlEngine)
     updateViewFactoryContextProperty();
 }
 
+void Platform::warmUpQmlComponents()
+{
+    if (!m_qmlEngine) {
+        qWarning() << Q_FUNC_INFO << "Please call setQmlEngine() first";
+        return;
+    }
+
+    const ViewFactory *factory = viewFactory();
+    QmlComponentCache::forEngine(m_qmlEngine)
+        ->warmUp({ factory->groupFilename().toString(), factory->titleBarFilename().toString(),
+                   factory->tabbarFilename().toString(), factory->separatorFilename().toString(),
+                   factory->floatingWindowFilename().toString(),
+                   factory->dockwidgetFilename().toString() });
+}
+
 void Platform::updateViewFactoryContextProperty()
 {
     if (!m_qmlEngine)
@@ -50,6 +50,12 @@ public:
     QSize screenSizeFor(Core::View *) const override;
     void setQmlEngine(QQmlEngine *);
     QQmlEngine *qmlEngine() const;
+
+    /// @brief Starts compiling the QML files of the view factory in the background
+    /// These are the group, title bar, tab bar, separator, floating window and dock widget files,
+    /// including any overridden by a custom ViewFactory.
+    /// Optional. Call it after setQmlEngine(), so the first views created don't pay for compilation.
+    void warmUpQmlComponents();
     Core::View *createView(Core::Controller *controller, Core::View *parent = nullptr) const override;
     bool usesFallbackMouseGrabber() const override;
     bool inDisallowedDragView(QPoint globalPos) const override;
@@ -0,0 +1,109 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "QmlComponentCache_p.h"
+
+#include <QDebug>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::QtQuick;
+
+QmlComponentCache::QmlComponentCache(QQmlEngine *engine)
+    : QObject(engine)
+    , m_engine(engine)
+{
+}
+
+QmlComponentCache *QmlComponentCache::forEngine(QQmlEngine *engine)
+{
+    if (!engine)
+        return nullptr;
+
+    if (auto cache = engine->findChild<QmlComponentCache *>(QString(), Qt::FindDirectChildrenOnly))
+        return cache;
+
+    return new QmlComponentCache(engine);
+}
+
+QQmlComponent *QmlComponentCache::component(const QString &filename)
+{
+    QQmlComponent *component = m_components.value(filename);
+    if (component && component->isReady())
+        return component;
+
+    if (component) {
+        // Still loading asynchronously, or failed. Load it synchronously, as we need it now.
+        m_components.remove(filename);
+        component->deleteLater();
+    }
+
+    component = load(filename, /*async=*/false);
+    if (!component->isReady()) {
+        // Not cached, so the next call tries again
+        if (component->isError()) {
+            qWarning() << Q_FUNC_INFO << component->errorString();
+        } else {
+            qWarning() << Q_FUNC_INFO << "Component couldn't be loaded synchronously" << filename;
+        }
+
+        m_components.remove(filename);
+        delete component;
+        return nullptr;
+    }
+
+    return component;
+}
+
+QQuickItem *QmlComponentCache::createItem(const QString &filename, QQmlContext *context)
+{
+    QQmlComponent *component = this->component(filename);
+    if (!component)
+        return nullptr;
+
+    QObject *obj = component->create(context);
+    if (!obj) {
+        qWarning() << Q_FUNC_INFO << component->errorString();
+        return nullptr;
+    }
+
+    return qobject_cast<QQuickItem *>(obj);
+}
+
+void QmlComponentCache::warmUp(const QStringList &filenames)
+{
+    for (const QString &filename : filenames) {
+        if (!filename.isEmpty() && !m_components.contains(filename))
+            load(filename, /*async=*/true);
+    }
+}
+
+bool QmlComponentCache::isReady(const QString &filename) const
+{
+    QQmlComponent *component = m_components.value(filename);
+    return component && component->isReady();
+}
+
+void QmlComponentCache::clear()
+{
+    qDeleteAll(m_components);
+    m_components.clear();
+}
+
+QQmlComponent *QmlComponentCache::load(const QString &filename, bool async)
+{
+    auto component = new QQmlComponent(
+        m_engine, filename, async ? QQmlComponent::Asynchronous : QQmlComponent::PreferSynchronous, this);
+    m_components.insert(filename, component);
+    return component;
+}
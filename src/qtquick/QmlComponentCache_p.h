@@ -0,0 +1,66 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include "kddockwidgets/docks_export.h"
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+QT_BEGIN_NAMESPACE
+class QQmlComponent;
+class QQmlContext;
+class QQmlEngine;
+class QQuickItem;
+QT_END_NAMESPACE
+
+namespace KDDockWidgets::QtQuick {
+
+/// @internal
+/// Compiled QQmlComponents, keyed by filename, so creating a group, title bar, etc.
+/// doesn't construct and load a new component each time.
+/// There's one cache per QQmlEngine, owned by the engine.
+class DOCKS_EXPORT QmlComponentCache : public QObject
+{
+    Q_OBJECT
+public:
+    /// Returns the cache for @p engine, creating it if needed
+    static QmlComponentCache *forEngine(QQmlEngine *engine);
+
+    /// Returns the component for @p filename, loading it synchronously if it's not cached yet,
+    /// or if it's still being loaded by warmUp().
+    /// Returns nullptr if the file doesn't exist or doesn't compile, errors aren't cached.
+    QQmlComponent *component(const QString &filename);
+
+    /// Convenience that creates an object from component() and casts it to QQuickItem
+    QQuickItem *createItem(const QString &filename, QQmlContext *context = nullptr);
+
+    /// Starts loading @p filenames asynchronously, so that later component() calls are cheap.
+    /// Files already cached are skipped.
+    void warmUp(const QStringList &filenames);
+
+    /// Returns whether @p filename has a component ready to use
+    bool isReady(const QString &filename) const;
+
+    /// Drops all components. Objects that were already created from them aren't affected.
+    void clear();
+
+private:
+    explicit QmlComponentCache(QQmlEngine *engine);
+    QQmlComponent *load(const QString &filename, bool async);
+
+    QQmlEngine *const m_engine;
+    QHash<QString, QQmlComponent *> m_components;
+};
+
+}
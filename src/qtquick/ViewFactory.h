@@ -74,6 +74,7 @@ public:
 
     /// Called by QML
     Q_INVOKABLE virtual QUrl titleBarFilename() const;
+    /// For groups with many tabs, views/qml/ScrollableTabBar.qml only instantiates the visible ones
     Q_INVOKABLE virtual QUrl tabbarFilename() const;
 
     /// Called by C++
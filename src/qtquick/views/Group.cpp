@@ -21,6 +21,7 @@
 #include "qtquick/views/DockWidget.h"
 #include "qtquick/ViewFactory.h"
 #include "qtquick/Platform.h"
+#include "qtquick/QmlComponentCache_p.h"
 #include "qtquick/views/TabBar.h"
 #include "qtquick/views/ViewWrapper_p.h"
 
@@ -40,6 +41,7 @@
 #include "core/TabBar_p.h"
 
 #include <QDebug>
+#include <QQmlComponent>
 
 using namespace KDDockWidgets;
 using namespace KDDockWidgets::QtQuick;
@@ -105,12 +107,14 @@ void Group::init()
         }
     });
 
-    QQmlComponent component(plat()->qmlEngine(), plat()->viewFactory()->groupFilename());
-
-    m_visualItem = static_cast<QQuickItem *>(component.create());
+    const QString filename = plat()->viewFactory()->groupFilename().toString();
+    auto cache = QmlComponentCache::forEngine(plat()->qmlEngine());
+    QQmlComponent *component = cache ? cache->component(filename) : nullptr;
+    m_visualItem = component ? qobject_cast<QQuickItem *>(component->create()) : nullptr;
 
     if (!m_visualItem) {
-        qWarning() << Q_FUNC_INFO << "Failed to create item" << component.errorString();
+        qWarning() << Q_FUNC_INFO << "Failed to create item" << filename
+                   << (component ? component->errorString() : QString());
         return;
     }
 
@@ -35,7 +35,9 @@
 
 #include "kdbindings/signal.h"
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 using namespace KDDockWidgets;
 using namespace KDDockWidgets::QtQuick;
@@ -48,10 +50,69 @@ public:
     {
     }
 
+    struct TabGeometry
+    {
+        int index = -1;
+        QPointer<QQuickItem> tab;
+        QRectF rect;
+    };
+
+    /// Whether the tab delegates report their geometry, see updateTabGeometry()
+    bool hasTabGeometries() const
+    {
+        return m_tabsParent && !m_tabGeometries.empty();
+    }
+
+    /// Whether indexAt() can be used. Not the case if the tabs aren't laid out left to right,
+    /// with LayoutMirroring for example, then we ask the QML tab bar instead.
+    bool canHitTest() const
+    {
+        return hasTabGeometries() && m_tabsLeftToRight;
+    }
+
+    void updateTabsLeftToRight()
+    {
+        m_tabsLeftToRight = std::is_sorted(m_tabGeometries.cbegin(), m_tabGeometries.cend(),
+                                           [](const TabGeometry &a, const TabGeometry &b) {
+                                               return a.rect.left() < b.rect.left();
+                                           });
+    }
+
+    /// Returns the cached tab at @p index, nullptr if it isn't instantiated
+    const TabGeometry *tabGeometry(int index) const
+    {
+        auto it = std::lower_bound(m_tabGeometries.cbegin(), m_tabGeometries.cend(), index,
+                                   [](const TabGeometry &tab, int i) { return tab.index < i; });
+        if (it == m_tabGeometries.cend() || it->index != index || !it->tab)
+            return nullptr;
+
+        return &*it;
+    }
+
+    /// Returns the index of the tab containing @p pt, which is in m_tabsParent coordinates
+    int indexAt(QPointF pt) const
+    {
+        // Tabs are laid out left to right, so sorting by index also sorts by x. See canHitTest().
+        auto it = std::upper_bound(m_tabGeometries.cbegin(), m_tabGeometries.cend(), pt.x(),
+                                   [](qreal x, const TabGeometry &tab) { return x < tab.rect.left(); });
+        if (it == m_tabGeometries.cbegin())
+            return -1;
+
+        --it;
+        return it->tab && it->rect.contains(pt) ? it->index : -1;
+    }
+
     int m_hoveredTabIndex = -1;
     QPointer<QQuickItem> m_tabBarQmlItem;
     DockWidgetModel *const m_dockWidgetModel;
     KDBindings::ScopedConnection m_tabBarAutoHideChanged;
+
+    /// The instantiated tab delegates, sorted by index
+    std::vector<TabGeometry> m_tabGeometries;
+    /// The item all tab delegates are children of, m_tabGeometries rects are relative to it
+    QPointer<QQuickItem> m_tabsParent;
+    /// Whether m_tabGeometries is also sorted by x
+    bool m_tabsLeftToRight = true;
 };
 
 class DockWidgetModel::Private
@@ -105,6 +166,12 @@ int TabBar::tabAt(QPoint localPt) const
         return -1;
     }
 
+    if (d->canHitTest()) {
+        const int index = d->indexAt(d->m_tabBarQmlItem->mapToItem(d->m_tabsParent, QPointF(localPt)));
+        // Like TabBar.qml's getTabIndexAtPosition(), which this replaces
+        return index == -1 ? d->m_dockWidgetModel->currentIndex() : index;
+    }
+
     const QPointF globalPos = d->m_tabBarQmlItem->mapToGlobal(localPt);
 
     QVariant index;
@@ -144,6 +211,12 @@ QString TabBar::text(int index) const
 
 QRect TabBar::rectForTab(int index) const
 {
+    if (d->hasTabGeometries()) {
+        if (auto tab = d->tabGeometry(index))
+            return QRectF(QPointF(0, 0), tab->rect.size()).toRect();
+        return {};
+    }
+
     if (QQuickItem *item = tabAt(index))
         return item->boundingRect().toRect();
 
@@ -152,6 +225,15 @@ QRect TabBar::rectForTab(int index) const
 
 QRect TabBar::globalRectForTab(int index) const
 {
+    if (d->hasTabGeometries()) {
+        if (auto tab = d->tabGeometry(index)) {
+            QRectF r = tab->rect;
+            r.moveTopLeft(d->m_tabsParent->mapToGlobal(r.topLeft()));
+            return r.toRect();
+        }
+        return {};
+    }
+
     if (QQuickItem *item = tabAt(index)) {
         QRect r = item->boundingRect().toRect();
         r.moveTopLeft(item->mapToGlobal(r.topLeft()).toPoint());
@@ -192,6 +274,9 @@ bool TabBar::event(QEvent *ev)
 
 QQuickItem *TabBar::tabAt(int index) const
 {
+    if (auto tab = d->tabGeometry(index))
+        return tab->tab;
+
     QVariant result;
     const bool res = QMetaObject::invokeMethod(
         d->m_tabBarQmlItem, "getTabAtIndex", Q_RETURN_ARG(QVariant, result), Q_ARG(QVariant, index));
@@ -279,6 +364,9 @@ void TabBar::onHoverEvent(QHoverEvent *ev, QPoint globalPos)
 
 int TabBar::indexForTabPos(QPoint globalPt) const
 {
+    if (d->canHitTest())
+        return d->indexAt(d->m_tabsParent->mapFromGlobal(QPointF(globalPt)));
+
     const int count = d->m_dockWidgetModel->count();
     for (int i = 0; i < count; i++) {
         const QRect tabRect = globalRectForTab(i);
@@ -289,6 +377,46 @@ int TabBar::indexForTabPos(QPoint globalPt) const
     return -1;
 }
 
+void TabBar::updateTabGeometry(QQuickItem *tab, int index)
+{
+    if (!tab || !tab->parentItem())
+        return;
+
+    // Linear, but only over the instantiated tabs, and this only runs when they're laid out
+    removeTabGeometry(tab);
+
+    if (tab->parentItem() != d->m_tabsParent) {
+        if (d->hasTabGeometries()) {
+            // Not in the tab strip yet. QQC2's TabBar, for example, reparents its tabs into it
+            // after creating them. It will report again once it's there.
+            return;
+        }
+
+        // First tab, or the tab strip was recreated
+        d->m_tabGeometries.clear();
+        d->m_tabsParent = tab->parentItem();
+    }
+
+    Private::TabGeometry geometry;
+    geometry.index = index;
+    geometry.tab = tab;
+    geometry.rect = QRectF(tab->position(), tab->size());
+
+    auto it = std::lower_bound(d->m_tabGeometries.begin(), d->m_tabGeometries.end(), index,
+                               [](const Private::TabGeometry &g, int i) { return g.index < i; });
+    d->m_tabGeometries.insert(it, geometry);
+    d->updateTabsLeftToRight();
+}
+
+void TabBar::removeTabGeometry(QQuickItem *tab)
+{
+    // Also drops the tabs which were deleted without telling us
+    d->m_tabGeometries.erase(std::remove_if(d->m_tabGeometries.begin(), d->m_tabGeometries.end(),
+                                            [tab](const Private::TabGeometry &g) { return !g.tab || g.tab == tab; }),
+                             d->m_tabGeometries.end());
+    d->updateTabsLeftToRight();
+}
+
 void TabBar::setHoveredTabIndex(int idx)
 {
     if (idx == d->m_hoveredTabIndex)
@@ -90,6 +90,16 @@ public:
     Q_INVOKABLE void addDockWidgetAsTab(QQuickItem *other,
                                         KDDockWidgets::InitialVisibilityOption = {});
 
+    /// @brief Called by the tab delegates whenever their index or geometry changes
+    /// Lets tabAt(), rectForTab() and hover detection find tabs by binary search instead of
+    /// asking QML to iterate them. Tab bars which don't call this still work, but slower.
+    /// All tabs should share the same parent, and be laid out left to right, by index.
+    Q_INVOKABLE void updateTabGeometry(QQuickItem *tab, int index);
+
+    /// @brief Called by the tab delegates when they're destroyed
+    /// With a virtualized tab strip, only the visible tabs are instantiated.
+    Q_INVOKABLE void removeTabGeometry(QQuickItem *tab);
+
 Q_SIGNALS:
     void tabBarQmlItemChanged();
     void tabBarAutoHideChanged();
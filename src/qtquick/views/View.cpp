@@ -17,6 +17,7 @@
 #include "core/ScopedValueRollback_p.h"
 #include "qtquick/Window_p.h"
 #include "qtquick/Platform.h"
+#include "qtquick/QmlComponentCache_p.h"
 #include "core/Group.h"
 
 #include <QtQuick/private/qquickitem_p.h>
@@ -161,14 +162,12 @@ void View::setGeometry(QRect rect)
 
 QQuickItem *View::createItem(QQmlEngine *engine, const QString &filename, QQmlContext *context)
 {
-    QQmlComponent component(engine, filename);
-    QObject *obj = component.create(context);
-    if (!obj) {
-        qWarning() << Q_FUNC_INFO << component.errorString();
+    if (!engine) {
+        qWarning() << Q_FUNC_INFO << "No engine";
         return nullptr;
     }
 
-    return qobject_cast<QQuickItem *>(obj);
+    return QmlComponentCache::forEngine(engine)->createItem(filename, context);
 }
 
 void View::redirectMouseEvents(QQuickItem *source)
@@ -888,17 +887,15 @@ QQuickItem *View::createItem(const QString &filename, QQuickItem *parent, QQmlCo
         return nullptr;
     }
 
-    if (!QFile::exists(cleanQRCFilename(filename))) {
+    QmlComponentCache *cache = QmlComponentCache::forEngine(engine);
+    if (!cache->isReady(filename) && !QFile::exists(cleanQRCFilename(filename))) {
         qWarning() << Q_FUNC_INFO << "File not found" << filename;
         return nullptr;
     }
 
-    QQmlComponent component(engine, filename);
-    auto qquickitem = qobject_cast<QQuickItem *>(component.create(ctx));
-    if (!qquickitem) {
-        qWarning() << Q_FUNC_INFO << component.errorString();
+    auto qquickitem = cache->createItem(filename, ctx);
+    if (!qquickitem)
         return nullptr;
-    }
 
     qquickitem->setParentItem(parent);
     qquickitem->QObject::setParent(parent);
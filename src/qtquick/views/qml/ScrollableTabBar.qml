@@ -0,0 +1,89 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+
+/// A tab bar which scrolls horizontally when its tabs don't fit, and only instantiates the
+/// visible ones. Suitable for groups with many tabs.
+/// To use it, return "qrc:/kddockwidgets/qtquick/views/qml/ScrollableTabBar.qml" from
+/// your ViewFactory::tabbarFilename() override.
+TabBarBase {
+    id: root
+
+    function getTabAtIndex(index) {
+        // null if the tab is scrolled out of view, as it's not instantiated
+        return listView.itemAtIndex(index);
+    }
+
+    function getTabIndexAtPosition(globalPoint) {
+        var localPt = listView.mapFromGlobal(globalPoint.x, globalPoint.y);
+        var index = listView.indexAt(localPt.x + listView.contentX, localPt.y + listView.contentY);
+        return index == -1 ? root.currentTabIndex : index;
+    }
+
+    implicitHeight: heightMetrics.implicitHeight
+
+    onCurrentTabIndexChanged: {
+        listView.currentIndex = root.currentTabIndex;
+        if (root.currentTabIndex != -1)
+            listView.positionViewAtIndex(root.currentTabIndex, ListView.Contain);
+    }
+
+    // Only used to know the height of a tab, as we might have none instantiated yet
+    TabButton {
+        id: heightMetrics
+        visible: false
+        text: "M"
+    }
+
+    ListView {
+        id: listView
+
+        anchors.fill: parent
+        orientation: ListView.Horizontal
+        clip: true
+        boundsBehavior: Flickable.StopAtBounds
+
+        // Clicks are handled in C++, which sets root.currentTabIndex
+        interactive: false
+        highlightFollowsCurrentItem: false
+
+        model: root.tabBarCpp ? root.tabBarCpp.dockWidgetModel : 0
+
+        delegate: TabButton {
+            id: tabButton
+            readonly property int tabIndex: index
+            text: title
+            checked: tabIndex == root.currentTabIndex
+            height: listView.height
+
+            onTabIndexChanged: root.tabGeometryChanged(tabButton)
+            onXChanged: root.tabGeometryChanged(tabButton)
+            onYChanged: root.tabGeometryChanged(tabButton)
+            onWidthChanged: root.tabGeometryChanged(tabButton)
+            onHeightChanged: root.tabGeometryChanged(tabButton)
+            Component.onCompleted: root.tabGeometryChanged(tabButton)
+            Component.onDestruction: root.tabDestroyed(tabButton)
+        }
+
+        // Mouse wheel scrolls the tabs, as the view itself isn't interactive
+        WheelHandler {
+            onWheel: function(event) {
+                var delta = event.angleDelta.y != 0 ? event.angleDelta.y : event.angleDelta.x;
+                listView.contentX = Math.max(0, Math.min(listView.contentWidth - listView.width,
+                                                         listView.contentX - delta));
+            }
+        }
+
+        ScrollIndicator.horizontal: ScrollIndicator { }
+    }
+}
@@ -102,8 +102,18 @@ TabBarBase {
             /// The list of tabs is stored in a C++ model. This repeater populates our TabBar.
             model: root.groupCpp ? root.groupCpp.tabBar.dockWidgetModel : 0
             TabButton {
+                id: tabButton
                 readonly property int tabIndex: index
                 text: title
+
+                onTabIndexChanged: root.tabGeometryChanged(tabButton)
+                onParentChanged: root.tabGeometryChanged(tabButton)
+                onXChanged: root.tabGeometryChanged(tabButton)
+                onYChanged: root.tabGeometryChanged(tabButton)
+                onWidthChanged: root.tabGeometryChanged(tabButton)
+                onHeightChanged: root.tabGeometryChanged(tabButton)
+                Component.onCompleted: root.tabGeometryChanged(tabButton)
+                Component.onDestruction: root.tabDestroyed(tabButton)
             }
         }
     }
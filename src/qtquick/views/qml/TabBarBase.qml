@@ -72,6 +72,20 @@ Item {
         }
     }
 
+    /// Tab delegates should call this whenever their tabIndex or geometry changes, and
+    /// tabDestroyed() when they're destroyed. See TabBar.qml for an example.
+    /// Lets C++ find tabs by position without calling getTabIndexAtPosition(), which visits
+    /// every tab. Optional, but recommended for groups with many tabs.
+    function tabGeometryChanged(tab) {
+        if (tabBarCpp)
+            tabBarCpp.updateTabGeometry(tab, tab.tabIndex);
+    }
+
+    function tabDestroyed(tab) {
+        if (tabBarCpp)
+            tabBarCpp.removeTabGeometry(tab);
+    }
+
     /// Returns the QQuickItem* that implements the Tab
     /// This is called by C++ and needs to be implemented in the derived class.
     /// See TabBar.qml for an example.
@@ -25,6 +25,7 @@
 #include "kddockwidgets/core/MainWindow.h"
 #include "kddockwidgets/core/FloatingWindow.h"
 #include "kddockwidgets/core/Layout.h"
+#include "kddockwidgets/core/MemoryReport.h"
 
 #include "qtwidgets/views/MainWindow.h"
 
@@ -215,6 +216,13 @@ DebugWindow::DebugWindow(QWidget *parent)
         }
     });
 
+    button = new QPushButton(this);
+    button->setText(QStringLiteral("Memory report"));
+    layout->addWidget(button);
+    connect(button, &QPushButton::clicked, this, [] {
+        qDebug().noquote() << Core::MemoryReport::collect().toString();
+    });
+
     button = new QPushButton(this);
     button->setText(QStringLiteral("Detach central widget"));
     layout->addWidget(button);
@@ -0,0 +1,616 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/// Headless benchmark for the layouting engine.
+///
+/// Drives Core::ItemBoxContainer directly, without any GUI, through dummy LayoutingHost,
+/// LayoutingGuest and LayoutingSeparator implementations, similar to what
+/// src/core/layouting/examples/ does.
+///
+/// For each tree size and nesting depth it reports latency percentiles and the number of heap
+/// allocations per operation, for:
+///     insertItem, removeItem, setSize_recursive, requestSeparatorMove, layoutEqually_recursive
+///     and a full itemRange_recursive() traversal. Depth 1 is a single wide, flat container.
+///
+/// Usage: bench_layouting [--quick] [--sizes 10,100,1000] [--depths 1,2,4] [--samples N] [--seed N]
+///
+/// Allocations are counted by replacing the global operator new, which also catches the ones done
+/// inside the kddockwidgets shared library on ELF platforms. On Windows only the allocations done by
+/// the benchmark itself would be seen, so the column isn't meaningful there.
+
+#include "core/layouting/Item_p.h"
+#include "core/layouting/LayoutingHost_p.h"
+#include "core/layouting/LayoutingGuest_p.h"
+#include "core/layouting/LayoutingSeparator_p.h"
+
+#ifdef KDDW_FRONTEND_QT
+#include <QCoreApplication>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace KDDockWidgets;
+
+namespace {
+
+std::size_t s_numAllocations = 0;
+
+}
+
+void *operator new(std::size_t sz)
+{
+    ++s_numAllocations;
+    if (void *ptr = std::malloc(sz == 0 ? 1 : sz))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t sz)
+{
+    return ::operator new(sz);
+}
+
+void *operator new(std::size_t sz, const std::nothrow_t &) noexcept
+{
+    ++s_numAllocations;
+    return std::malloc(sz == 0 ? 1 : sz);
+}
+
+void *operator new[](std::size_t sz, const std::nothrow_t &) noexcept
+{
+    return ::operator new(sz, std::nothrow);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+class Host;
+
+/// Separators only need to remember their geometry
+class Separator : public Core::LayoutingSeparator
+{
+public:
+    using Core::LayoutingSeparator::setGeometry;
+
+    explicit Separator(Core::LayoutingHost *host, Qt::Orientation orientation, Core::ItemBoxContainer *container)
+        : Core::LayoutingSeparator(host, orientation, container)
+    {
+    }
+
+    Rect geometry() const override
+    {
+        return m_geometry;
+    }
+
+    void setGeometry(Rect r) override
+    {
+        m_geometry = r;
+    }
+
+private:
+    Rect m_geometry;
+};
+
+class Host : public Core::LayoutingHost
+{
+public:
+    Host()
+    {
+        m_rootItem = new Core::ItemBoxContainer(this);
+        m_rootItem->setSize_recursive(Size(1920, 1080));
+    }
+
+    ~Host() override
+    {
+        delete m_rootItem;
+    }
+
+    bool supportsHonouringLayoutMinSize() const override
+    {
+        return true;
+    }
+
+    Core::ItemBoxContainer *root() const
+    {
+        return m_rootItem->asBoxContainer();
+    }
+};
+
+/// A guest which just stores what the layout tells it
+class Guest : public Core::LayoutingGuest
+{
+public:
+    explicit Guest(Host *host, int id)
+        : m_id(QString::number(id))
+    {
+        m_item = new Core::Item(host);
+        m_item->setGuest(this);
+    }
+
+    ~Guest() override
+    {
+        beingDestroyed.emit();
+    }
+
+    Size minSize() const override
+    {
+        // Same as the default min-size of a real dock widget's group
+        return Core::Item::hardcodedMinimumSize;
+    }
+
+    Size maxSizeHint() const override
+    {
+        return Core::Item::hardcodedMaximumSize;
+    }
+
+    void setGeometry(Rect r) override
+    {
+        m_geometry = r;
+    }
+
+    void setVisible(bool is) override
+    {
+        m_isVisible = is;
+    }
+
+    Rect geometry() const override
+    {
+        return m_geometry;
+    }
+
+    void setHost(Core::LayoutingHost *host) override
+    {
+        m_host = host;
+    }
+
+    Core::LayoutingHost *host() const override
+    {
+        return m_host;
+    }
+
+    QString id() const override
+    {
+        return m_id;
+    }
+
+    Core::Item *item() const
+    {
+        return m_item;
+    }
+
+private:
+    const QString m_id;
+    Core::Item *m_item = nullptr;
+    Core::LayoutingHost *m_host = nullptr;
+    Rect m_geometry;
+    bool m_isVisible = false;
+};
+
+struct Options
+{
+    std::vector<int> sizes = { 10, 100, 1000, 10000 };
+    std::vector<int> depths = { 1, 2, 4 };
+    int samples = 200;
+    unsigned int seed = 1;
+    bool checkSanity = false;
+};
+
+struct Sample
+{
+    double micros = 0;
+    std::size_t allocations = 0;
+};
+
+/// Measures @p func, which is expected to run a single layout operation
+template<typename Func>
+Sample measure(Func &&func)
+{
+    const std::size_t allocationsBefore = s_numAllocations;
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto end = std::chrono::steady_clock::now();
+
+    Sample sample;
+    sample.micros = std::chrono::duration<double, std::micro>(end - start).count();
+    sample.allocations = s_numAllocations - allocationsBefore;
+    return sample;
+}
+
+double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+
+    const auto index = std::min(sorted.size() - 1, size_t(std::ceil(p * double(sorted.size())) - 1));
+    return sorted[index];
+}
+
+void report(const char *operation, int numItems, int depth, const std::vector<Sample> &samples)
+{
+    if (samples.empty()) {
+        std::printf("%-24s %7d %5d %8s\n", operation, numItems, depth, "n/a");
+        return;
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(samples.size());
+    double totalAllocations = 0;
+    for (const Sample &sample : samples) {
+        latencies.push_back(sample.micros);
+        totalAllocations += double(sample.allocations);
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("%-24s %7d %5d %8zu %10.1f %10.1f %10.1f %10.1f %12.1f\n", operation, numItems, depth,
+                samples.size(), percentile(latencies, 0.5), percentile(latencies, 0.9),
+                percentile(latencies, 0.99), latencies.back(), totalAllocations / double(samples.size()));
+}
+
+/// A layout with @p numItems guests nested @p depth levels deep
+class Scenario
+{
+public:
+    Scenario(int numItems, int depth, unsigned int seed)
+        : m_depth(std::max(1, depth))
+        , m_random(seed)
+    {
+        // How many children each container gets so that we reach numItems leaves at the desired depth
+        m_fanout = std::max(2, int(std::ceil(std::pow(double(numItems), 1.0 / m_depth))));
+
+        Guest *first = newGuest();
+        m_host.root()->insertItem(first->item(), Location_OnLeft);
+        split(first->item(), numItems, 0);
+    }
+
+    ~Scenario()
+    {
+        // Delete the layout before the guests, so guests don't trigger item removal
+        delete m_host.m_rootItem;
+        m_host.m_rootItem = nullptr;
+    }
+
+    Core::ItemBoxContainer *root() const
+    {
+        return m_host.root();
+    }
+
+    Core::Item *randomLeaf()
+    {
+        std::uniform_int_distribution<size_t> dist(0, m_leaves.size() - 1);
+        return m_leaves[dist(m_random)];
+    }
+
+    Core::LayoutingSeparator *randomSeparator()
+    {
+        const auto separators = root()->separators_recursive();
+        if (separators.isEmpty())
+            return nullptr;
+
+        std::uniform_int_distribution<int> dist(0, int(separators.size()) - 1);
+        return separators.at(dist(m_random));
+    }
+
+    int randomInt(int min, int max)
+    {
+        std::uniform_int_distribution<int> dist(min, max);
+        return dist(m_random);
+    }
+
+    Guest *newGuest()
+    {
+        m_guests.push_back(std::make_unique<Guest>(&m_host, m_nextId++));
+        Guest *guest = m_guests.back().get();
+        m_leaves.push_back(guest->item());
+        return guest;
+    }
+
+    void forgetLeaf(Core::Item *item)
+    {
+        m_leaves.erase(std::remove(m_leaves.begin(), m_leaves.end(), item), m_leaves.end());
+    }
+
+private:
+    static Location locationForLevel(int level)
+    {
+        // Alternate orientations, so each nesting level produces a new container
+        return level % 2 == 0 ? Location_OnRight : Location_OnBottom;
+    }
+
+    /// Replaces @p leaf with @p count leaves, nested (m_depth - level) levels deep
+    void split(Core::Item *leaf, int count, int level)
+    {
+        if (count <= 1)
+            return;
+
+        const bool isLastLevel = level >= m_depth - 1;
+        const int numGroups = isLastLevel ? count : std::min(m_fanout, count);
+        const Location loc = locationForLevel(level);
+
+        std::vector<Core::Item *> groupLeaves = { leaf };
+        Core::Item *previous = leaf;
+        for (int i = 1; i < numGroups; ++i) {
+            Guest *guest = newGuest();
+            Core::ItemBoxContainer::insertItemRelativeTo(guest->item(), previous, loc);
+            previous = guest->item();
+            groupLeaves.push_back(previous);
+        }
+
+        if (isLastLevel)
+            return;
+
+        // Distribute the remaining leaves among the groups we just created
+        const int perGroup = count / numGroups;
+        int extra = count % numGroups;
+        for (Core::Item *groupLeaf : groupLeaves) {
+            const int groupCount = perGroup + (extra > 0 ? 1 : 0);
+            if (extra > 0)
+                --extra;
+            split(groupLeaf, groupCount, level + 1);
+        }
+    }
+
+    Host m_host;
+    int m_depth = 1;
+    int m_fanout = 2;
+    int m_nextId = 0;
+    std::mt19937 m_random;
+    std::vector<std::unique_ptr<Guest>> m_guests;
+    std::vector<Core::Item *> m_leaves;
+};
+
+void benchInsertAndRemove(Scenario &scenario, int numItems, int depth, int numSamples)
+{
+    std::vector<Sample> insertSamples;
+    std::vector<Sample> removeSamples;
+    insertSamples.reserve(size_t(numSamples));
+    removeSamples.reserve(size_t(numSamples));
+
+    const Location locations[] = { Location_OnLeft, Location_OnTop, Location_OnRight, Location_OnBottom };
+
+    for (int i = 0; i < numSamples; ++i) {
+        // Keep the tree at the same size, by removing what we added
+        Core::Item *relativeTo = scenario.randomLeaf();
+        Guest *guest = scenario.newGuest();
+        Core::Item *item = guest->item();
+        const Location loc = locations[i % 4];
+
+        insertSamples.push_back(measure([&] {
+            Core::ItemBoxContainer::insertItemRelativeTo(item, relativeTo, loc);
+        }));
+
+        scenario.forgetLeaf(item);
+        removeSamples.push_back(measure([&] {
+            scenario.root()->removeItem(item);
+        }));
+    }
+
+    report("insertItem", numItems, depth, insertSamples);
+    report("removeItem", numItems, depth, removeSamples);
+}
+
+void benchSetSize(Scenario &scenario, int numItems, int depth, int numSamples)
+{
+    std::vector<Sample> samples;
+    samples.reserve(size_t(numSamples));
+
+    Core::ItemBoxContainer *root = scenario.root();
+    const Size originalSize = root->size();
+
+    for (int i = 0; i < numSamples; ++i) {
+        // Alternate between growing and shrinking, like a user resizing the window back and forth
+        const int delta = (i % 2 == 0) ? 37 : -37;
+        const Size newSize = (root->size() + Size(delta, delta)).expandedTo(root->minSize());
+        samples.push_back(measure([&] {
+            root->setSize_recursive(newSize);
+        }));
+    }
+
+    root->setSize_recursive(originalSize.expandedTo(root->minSize()));
+    report("setSize_recursive", numItems, depth, samples);
+}
+
+void benchSeparatorMove(Scenario &scenario, int numItems, int depth, int numSamples)
+{
+    std::vector<Sample> samples;
+    samples.reserve(size_t(numSamples));
+
+    for (int i = 0; i < numSamples; ++i) {
+        Core::LayoutingSeparator *separator = scenario.randomSeparator();
+        if (!separator)
+            break;
+
+        Core::ItemBoxContainer *container = separator->parentContainer();
+        const int pos = separator->position();
+        const int min = container->minPosForSeparator_global(separator);
+        const int max = container->maxPosForSeparator_global(separator);
+        if (max <= min)
+            continue; // Neighbours are already at their min size, separator can't move
+
+        const int newPos = scenario.randomInt(min, max);
+        if (newPos == pos)
+            continue;
+
+        samples.push_back(measure([&] {
+            container->requestSeparatorMove(separator, newPos - pos);
+        }));
+    }
+
+    report("requestSeparatorMove", numItems, depth, samples);
+}
+
+void benchLayoutEqually(Scenario &scenario, int numItems, int depth, int numSamples)
+{
+    std::vector<Sample> samples;
+    samples.reserve(size_t(numSamples));
+
+    Core::ItemBoxContainer *root = scenario.root();
+    for (int i = 0; i < numSamples; ++i) {
+        samples.push_back(measure([&] {
+            root->layoutEqually_recursive();
+        }));
+    }
+
+    report("layoutEqually_recursive", numItems, depth, samples);
+}
+
+/// Returns false if the traversal doesn't visit the same items as items_recursive()
+bool benchItemRange(Scenario &scenario, int numItems, int depth, int numSamples, bool verify)
+{
+    std::vector<Sample> samples;
+    samples.reserve(size_t(numSamples));
+
+    Core::ItemBoxContainer *root = scenario.root();
+    int numVisited = 0;
+    for (int i = 0; i < numSamples; ++i) {
+        samples.push_back(measure([&] {
+            numVisited = 0;
+            for (Core::Item *item : root->itemRange_recursive()) {
+                (void)item;
+                ++numVisited;
+            }
+        }));
+    }
+
+    report("itemRange_recursive", numItems, depth, samples);
+
+    if (!verify)
+        return true;
+
+    const Core::Item::List expected = root->items_recursive();
+    if (numVisited != int(expected.size()))
+        return false;
+
+    int index = 0;
+    for (Core::Item *item : root->itemRange_recursive()) {
+        if (item != expected.at(index++))
+            return false;
+    }
+
+    return true;
+}
+
+std::vector<int> parseList(const char *str)
+{
+    std::vector<int> result;
+    std::string s(str);
+    size_t start = 0;
+    while (start < s.size()) {
+        const size_t end = s.find(',', start);
+        const std::string token = s.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        if (!token.empty())
+            result.push_back(std::atoi(token.c_str()));
+        if (end == std::string::npos)
+            break;
+        start = end + 1;
+    }
+
+    return result;
+}
+
+void printUsage()
+{
+    std::printf("Usage: bench_layouting [--quick] [--sizes 10,100,1000] [--depths 1,2,4] [--samples N] [--seed N]\n");
+}
+
+}
+
+int main(int argc, char **argv)
+{
+#ifdef KDDW_FRONTEND_QT
+    QCoreApplication app(argc, argv);
+#endif
+
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            // For ctest, just so the benchmark doesn't bitrot
+            options.sizes = { 10, 100 };
+            options.depths = { 1, 3 };
+            options.samples = 20;
+            options.checkSanity = true;
+        } else if (std::strcmp(argv[i], "--sizes") == 0 && hasValue) {
+            options.sizes = parseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--depths") == 0 && hasValue) {
+            options.depths = parseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--samples") == 0 && hasValue) {
+            options.samples = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = unsigned(std::atoi(argv[++i]));
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Core::Item::setCreateSeparatorFunc([](Core::LayoutingHost *host, Qt::Orientation orientation,
+                                          Core::ItemBoxContainer *container) -> Core::LayoutingSeparator * {
+        return new Separator(host, orientation, container);
+    });
+
+    // Latencies in microseconds
+    std::printf("%-24s %7s %5s %8s %10s %10s %10s %10s %12s\n", "operation", "items", "depth", "samples",
+                "p50(us)", "p90(us)", "p99(us)", "max(us)", "allocs/op");
+
+    for (int depth : options.depths) {
+        for (int numItems : options.sizes) {
+            if (numItems < 2)
+                continue;
+
+            Scenario scenario(numItems, depth, options.seed);
+            benchInsertAndRemove(scenario, numItems, depth, options.samples);
+            benchSetSize(scenario, numItems, depth, options.samples);
+            benchSeparatorMove(scenario, numItems, depth, options.samples);
+            benchLayoutEqually(scenario, numItems, depth, options.samples);
+            if (!benchItemRange(scenario, numItems, depth, options.samples, options.checkSanity)) {
+                std::fprintf(stderr, "itemRange_recursive() differs from items_recursive() with %d items at depth %d\n", numItems, depth);
+                return 1;
+            }
+
+            if (options.checkSanity && !scenario.root()->checkSanity()) {
+                std::fprintf(stderr, "Layout is invalid after benchmarking %d items at depth %d\n", numItems, depth);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+# This file is part of KDDockWidgets.
+#
+# SPDX-FileCopyrightText: 2024 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+# Author: Sergio Martins <sergio.martins@kdab.com>
+#
+# SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+#
+# Contact KDAB at <info@kdab.com> for commercial licensing options.
+#
+
+# Tests that a batch mode worker lints each file from a clean slate.
+# The same layout is linted alone, and then after a different one in the same worker,
+# both runs must report the same counts for it.
+#
+# Usage: cmake -DLINTER=<path> -DLAYOUTS_DIR=<path> -DOUTPUT_DIR=<path> -P linter_batch_test.cmake
+
+set(FIRST_LAYOUT ${LAYOUTS_DIR}/overlapping-item.json)
+set(SECOND_LAYOUT ${LAYOUTS_DIR}/sidebar_restore.json)
+
+function(run_linter output)
+    execute_process(
+        COMMAND ${LINTER} --jobs 1 --output ${output} ${ARGN}
+        RESULT_VARIABLE result
+    )
+
+    # 2 just means a layout failed linting, which isn't what's being tested
+    if(NOT result EQUAL 0 AND NOT result EQUAL 2)
+        message(FATAL_ERROR "Linter failed with ${result}")
+    endif()
+endfunction()
+
+# Returns the "counts" objects in the report, in file order
+function(read_counts file out)
+    file(READ ${file} report)
+    string(REGEX MATCHALL "\"counts\": {[^}]*}" counts "${report}")
+    set(${out} "${counts}" PARENT_SCOPE)
+endfunction()
+
+run_linter(${OUTPUT_DIR}/linter_batch_alone.json ${SECOND_LAYOUT})
+run_linter(${OUTPUT_DIR}/linter_batch_after.json ${FIRST_LAYOUT} ${SECOND_LAYOUT})
+
+read_counts(${OUTPUT_DIR}/linter_batch_alone.json alone)
+read_counts(${OUTPUT_DIR}/linter_batch_after.json after)
+
+list(LENGTH alone numAlone)
+list(LENGTH after numAfter)
+if(NOT numAlone EQUAL 1 OR NOT numAfter EQUAL 2)
+    message(FATAL_ERROR "Unexpected number of results: ${numAlone} and ${numAfter}")
+endif()
+
+list(GET after 1 secondAfterFirst)
+if(NOT alone STREQUAL secondAfterFirst)
+    message(FATAL_ERROR "Counts depend on the previous file.\nAlone: ${alone}\nAfter another file: ${secondAfterFirst}")
+endif()
@@ -20,9 +20,14 @@
 #include "qtquick/views/DockWidget.h"
 #include "qtquick/views/MainWindow.h"
 #include "qtquick/views/FloatingWindow.h"
+#include "qtquick/views/TabBar.h"
+#include "qtquick/QmlComponentCache_p.h"
+#include "qtquick/ViewFactory.h"
 #include "core/MDILayout.h"
 #include "core/views/MainWindowViewInterface.h"
 #include "core/MainWindow.h"
+#include "core/Group.h"
+#include "core/TabBar.h"
 #include "core/Window_p.h"
 #include "core/Platform.h"
 
@@ -34,7 +39,10 @@
 
 #include <QtTest/QTest>
 #include <QQmlApplicationEngine>
+#include <QQmlComponent>
 #include <QQmlContext>
+#include <QQuickItem>
+#include <QRegularExpression>
 
 using namespace KDDockWidgets;
 using namespace KDDockWidgets::Tests;
@@ -69,6 +77,8 @@ private Q_SLOTS:
     void tst_deleteDockWidget();
     void tst_setViewFactory();
     void tst_quickWindowCreationCallback();
+    void tst_qmlComponentCache();
+    void tst_tabBarGeometryCache();
 };
 
 
@@ -558,6 +568,120 @@ void TestQtQuick::tst_quickWindowCreationCallback()
     QtQuick::FloatingWindow::setQuickWindowCreationCallback(nullptr);
 }
 
+void TestQtQuick::tst_qmlComponentCache()
+{
+    EnsureTopLevelsDeleted e;
+    QQmlApplicationEngine engine(":/main2.qml");
+
+    auto cache = QtQuick::QmlComponentCache::forEngine(plat()->qmlEngine());
+    QVERIFY(cache);
+    QCOMPARE(cache, QtQuick::QmlComponentCache::forEngine(plat()->qmlEngine()));
+
+    // The main window already created a group, so its component is cached
+    const QString groupFilename = plat()->viewFactory()->groupFilename().toString();
+    QVERIFY(cache->isReady(groupFilename));
+
+    // Cache hits return the same component
+    QQmlComponent *component = cache->component(":/MyRectangle.qml");
+    QVERIFY(component);
+    QVERIFY(cache->isReady(":/MyRectangle.qml"));
+    QCOMPARE(component, cache->component(":/MyRectangle.qml"));
+
+    std::unique_ptr<QQuickItem> item(cache->createItem(":/MyRectangle.qml"));
+    QVERIFY(item);
+
+    // Errors aren't cached
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(".*"));
+    QVERIFY(!cache->component(":/doesNotExist.qml"));
+    QVERIFY(!cache->isReady(":/doesNotExist.qml"));
+
+    cache->clear();
+    QVERIFY(!cache->isReady(":/MyRectangle.qml"));
+
+    // warmUp() loads asynchronously, a synchronous request in the meantime still works
+    cache->warmUp({ ":/MyRectangle.qml" });
+    QVERIFY(cache->component(":/MyRectangle.qml"));
+    QVERIFY(cache->isReady(":/MyRectangle.qml"));
+}
+
+/// Compares what the TabBar finds through the geometry reported by the tab delegates against
+/// what TabBar.qml's own getTabAtIndex() and getTabIndexAtPosition() return
+static void compareWithQmlTabBar(QtQuick::TabBar *tabBar)
+{
+    QQuickItem *qmlItem = tabBar->tabBarQmlItem();
+    QVERIFY(qmlItem);
+
+    const int count = tabBar->dockWidgetModel()->count();
+    for (int i = 0; i < count; ++i) {
+        QVariant result;
+        QVERIFY(QMetaObject::invokeMethod(qmlItem, "getTabAtIndex", Q_RETURN_ARG(QVariant, result),
+                                          Q_ARG(QVariant, i)));
+        auto tab = result.value<QQuickItem *>();
+        QVERIFY(tab);
+
+        QCOMPARE(tabBar->rectForTab(i), tab->boundingRect().toRect());
+
+        const QPointF globalPos = tab->mapToGlobal(tab->boundingRect().center());
+        QCOMPARE(tabBar->indexForTabPos(globalPos.toPoint()), i);
+
+        QVERIFY(QMetaObject::invokeMethod(qmlItem, "getTabIndexAtPosition",
+                                          Q_RETURN_ARG(QVariant, result), Q_ARG(QVariant, globalPos)));
+        QCOMPARE(tabBar->tabAt(qmlItem->mapFromGlobal(globalPos).toPoint()), result.toInt());
+    }
+
+    // Outside of any tab
+    const QPointF globalPos = qmlItem->mapToGlobal(QPointF(1, qmlItem->height() + 10));
+    QCOMPARE(tabBar->indexForTabPos(globalPos.toPoint()), -1);
+
+    QVariant result;
+    QVERIFY(QMetaObject::invokeMethod(qmlItem, "getTabIndexAtPosition",
+                                      Q_RETURN_ARG(QVariant, result), Q_ARG(QVariant, globalPos)));
+    QCOMPARE(tabBar->tabAt(qmlItem->mapFromGlobal(globalPos).toPoint()), result.toInt());
+}
+
+void TestQtQuick::tst_tabBarGeometryCache()
+{
+    EnsureTopLevelsDeleted e;
+    QQmlApplicationEngine engine(":/main2.qml");
+
+    const auto mainWindows = DockRegistry::self()->mainwindows();
+    QCOMPARE(mainWindows.size(), 1);
+    MainWindow *m = mainWindows.first();
+
+    auto dock0 = createDockWidget(
+        "dock0", Platform::instance()->tests_createView({ true, {}, QSize(400, 400) }));
+    m->addDockWidget(dock0, Location_OnLeft);
+
+    for (int i = 1; i < 4; ++i) {
+        auto dock = createDockWidget(
+            QStringLiteral("dock%1").arg(i), Platform::instance()->tests_createView({ true, {}, QSize(400, 400) }));
+        dock0->addDockWidgetAsTab(dock);
+    }
+
+    Group *group = dock0->dptr()->group();
+    auto tabBar = static_cast<QtQuick::TabBar *>(group->tabBar()->view());
+    QTest::qWait(100);
+    compareWithQmlTabBar(tabBar);
+    if (QTest::currentTestFailed())
+        return;
+
+    // Inserting in the middle shifts the indexes of the following tabs
+    auto dock4 = createDockWidget(
+        "dock4", Platform::instance()->tests_createView({ true, {}, QSize(400, 400) }));
+    group->insertWidget(dock4, 1);
+    QTest::qWait(100);
+    QCOMPARE(tabBar->dockWidgetModel()->count(), 5);
+    compareWithQmlTabBar(tabBar);
+    if (QTest::currentTestFailed())
+        return;
+
+    // And so does removing
+    DockRegistry::self()->dockByName("dock2")->close();
+    QTest::qWait(100);
+    QCOMPARE(tabBar->dockWidgetModel()->count(), 4);
+    compareWithQmlTabBar(tabBar);
+}
+
 int main(int argc, char *argv[])
 {
 #ifdef KDDW_HAS_SPDLOG
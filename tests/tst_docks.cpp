@@ -39,8 +39,14 @@
 #include "core/Stack.h"
 #include "core/SideBar.h"
 #include "core/Platform.h"
+#include "core/Profiler.h"
+#include "core/MemoryReport.h"
+#include "core/WidgetResizeHandler_p.h"
 
+#include <chrono>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -126,6 +132,439 @@ KDDW_QCORO_TASK tst_minMaxGuest()
     KDDW_TEST_RETURN(true);
 }
 
+KDDW_QCORO_TASK tst_dockByName()
+{
+    // Tests that DockRegistry's name lookups follow registration, renames and deletion
+
+    EnsureTopLevelsDeleted e;
+    auto dr = DockRegistry::self();
+
+    auto dockA = createDockWidget("a", Platform::instance()->tests_createView({ true }), {}, {}, false);
+    auto dockB = createDockWidget("b", Platform::instance()->tests_createView({ true }), {}, {}, false);
+    CHECK_EQ(dr->dockByName("a"), dockA);
+    CHECK_EQ(dr->dockByName("b"), dockB);
+    CHECK(!dr->dockByName("c"));
+
+    dockA->setUniqueName("c");
+    CHECK(!dr->dockByName("a"));
+    CHECK_EQ(dr->dockByName("c"), dockA);
+    CHECK(dr->containsDockWidget("c"));
+
+    CHECK_EQ(dr->dockWidgets({ "b", "c", "d" }).size(), 2);
+
+    delete dockB;
+    CHECK(!dr->dockByName("b"));
+
+    auto m = createMainWindow(Size(500, 500), {}, "mw1");
+    CHECK_EQ(dr->mainWindowByName("mw1"), m.get());
+    CHECK(!dr->mainWindowByName("mw2"));
+
+    delete dockA;
+
+    // To process 1 event loop and do some delete later. Makes asan happy.
+    EVENT_LOOP(1);
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_restoreBinary()
+{
+    // Tests that the binary format round-trips, and that the JSON entry points accept it too
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }));
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    LayoutSaver saver;
+    const QByteArray binary = saver.serializeLayoutBinary();
+    const QByteArray json = saver.serializeLayout();
+    CHECK(!binary.isEmpty());
+    CHECK(LayoutSaver::Layout::isBinary(binary));
+    CHECK(!LayoutSaver::Layout::isBinary(json));
+    CHECK(binary.size() < json.size());
+    CHECK_EQ(LayoutSaver::openedDockWidgetsInLayout(binary), LayoutSaver::openedDockWidgetsInLayout(json));
+
+    dock2->close();
+    CHECK(saver.restoreLayoutBinary(binary));
+    CHECK(dock2->isOpen());
+    CHECK(m->layout()->checkSanity());
+
+    dock2->close();
+    CHECK(saver.restoreLayout(binary));
+    CHECK(dock2->isOpen());
+
+    {
+        SetExpectedWarning ignoreWarning("Data isn't in binary format");
+        CHECK(!saver.restoreLayoutBinary(json));
+    }
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_serializeLayoutIncremental()
+{
+    // Tests that incremental snapshots match a full serialization, and that patches reproduce them
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }));
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }));
+    auto dock3 = createDockWidget("3", Platform::instance()->tests_createView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    LayoutSaver saver;
+    const QByteArray patch1 = saver.serializeLayoutPatch();
+    QByteArray snapshot = LayoutSaver::applyLayoutPatch({}, patch1);
+    CHECK_EQ(snapshot, saver.serializeLayout());
+
+    // Nothing changed, the cached parts are reused
+    CHECK_EQ(saver.serializeLayoutIncremental(), saver.serializeLayout());
+    CHECK_EQ(saver.serializeLayoutPatch(), QByteArray::fromStdString("[]"));
+
+    // Tabbing, closing and floating invalidate the layout and the placeholders
+    dock1->addDockWidgetAsTab(dock3);
+    dock2->close();
+    CHECK_EQ(saver.serializeLayoutIncremental(), saver.serializeLayout());
+
+    snapshot = saver.serializeLayoutIncremental();
+    dock1->setFloating(true);
+    const QByteArray patch2 = saver.serializeLayoutPatch();
+    CHECK_EQ(LayoutSaver::applyLayoutPatch(snapshot, patch2), saver.serializeLayout());
+
+    {
+        SetExpectedWarning ignoreWarning("Failed to parse input");
+        CHECK(LayoutSaver::applyLayoutPatch(snapshot, "not json").isEmpty());
+    }
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_groupContainingPos()
+{
+    // Tests that the hovered group is found, and that the index follows layout changes
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    auto dropArea = m->dropArea();
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }));
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }));
+    auto dock3 = createDockWidget("3", Platform::instance()->tests_createView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    auto centerOf = [](Core::DockWidget *dw) {
+        Core::View *groupView = dw->dptr()->group()->view();
+        return groupView->mapToGlobal(groupView->rect().center());
+    };
+
+    CHECK_EQ(dropArea->groupContainingPos(centerOf(dock1)), dock1->dptr()->group());
+    CHECK_EQ(dropArea->groupContainingPos(centerOf(dock2)), dock2->dptr()->group());
+    CHECK(!dropArea->groupContainingPos(m->view()->mapToGlobal(Point(-10, -10))));
+
+    m->addDockWidget(dock3, Location_OnBottom);
+    CHECK_EQ(dropArea->groupContainingPos(centerOf(dock3)), dock3->dptr()->group());
+    CHECK_EQ(dropArea->groupContainingPos(centerOf(dock1)), dock1->dptr()->group());
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_profiler()
+{
+    // Tests that layouting and restoring are recorded, only while the profiler is enabled
+
+    if (!Core::Profiler::isAvailable()) {
+        // Built without -DKDDockWidgets_PROFILING=ON, nothing is ever recorded
+        SetExpectedWarning ignoreWarning("built without");
+        Core::Profiler::setEnabled(true);
+        CHECK(!Core::Profiler::isEnabled());
+        KDDW_TEST_RETURN(true);
+    }
+
+    EnsureTopLevelsDeleted e;
+    Core::Profiler::reset();
+    Core::Profiler::setEnabled(true);
+
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }));
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    LayoutSaver saver;
+    CHECK(saver.restoreLayout(saver.serializeLayout()));
+    Core::Profiler::setEnabled(false);
+
+    auto countOf = [](const QString &name) -> int64_t {
+        for (const Core::Profiler::Counter &counter : Core::Profiler::counters()) {
+            if (counter.name == name)
+                return counter.count;
+        }
+        return 0;
+    };
+
+    CHECK(countOf(QStringLiteral("ItemBoxContainer::updateSeparators")) > 0);
+    CHECK_EQ(countOf(QStringLiteral("LayoutSaver::restoreLayout")), 1);
+    CHECK_EQ(countOf(QStringLiteral("LayoutSaver::restoreLayout: placeholders")), 1);
+
+    const std::string trace = Core::Profiler::chromeTrace().constData();
+    CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    CHECK(trace.find("LayoutSaver::restoreLayout: main windows") != std::string::npos);
+
+    // Disabled, nothing else is recorded
+    const int64_t numUpdates = countOf(QStringLiteral("ItemBoxContainer::updateSeparators"));
+    m->addDockWidget(createDockWidget("3", Platform::instance()->tests_createView({ true })), Location_OnBottom);
+    CHECK_EQ(countOf(QStringLiteral("ItemBoxContainer::updateSeparators")), numUpdates);
+
+    Core::Profiler::reset();
+    CHECK(Core::Profiler::counters().isEmpty());
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_memoryReport()
+{
+    // Tests that the report counts what's in the layout, including placeholders of closed docks
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    // Not shown, so they never had a floating window, which would add placeholders of its own
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }), {}, {}, /*show=*/false);
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }), {}, {}, /*show=*/false);
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    Core::MemoryReport report = Core::MemoryReport::collect();
+    CHECK_EQ(report.entry(QStringLiteral("MainWindow")).count, 1);
+    CHECK_EQ(report.entry(QStringLiteral("DockWidget")).count, 2);
+    CHECK_EQ(report.entry(QStringLiteral("Group")).count, 2);
+    CHECK_EQ(report.entry(QStringLiteral("Item")).count, 2);
+    CHECK_EQ(report.entry(QStringLiteral("Item (placeholder)")).count, 0);
+    CHECK_EQ(report.entry(QStringLiteral("Separator")).count, 1);
+    CHECK_EQ(report.entry(QStringLiteral("Positions placeholder")).count, 2);
+    CHECK(report.totalEstimatedBytes() > 0);
+    CHECK(report.leakedPlaceholders().isEmpty());
+
+    dock1->close();
+    report = Core::MemoryReport::collect();
+    CHECK_EQ(report.entry(QStringLiteral("Item")).count, 1);
+    CHECK_EQ(report.entry(QStringLiteral("Item (placeholder)")).count, 1);
+    CHECK_EQ(report.entry(QStringLiteral("Positions placeholder")).count, 2);
+    CHECK(report.leakedPlaceholders().isEmpty());
+
+    const std::string json = report.toJson().constData();
+    CHECK(json.find("\"totalEstimatedBytes\"") != std::string::npos);
+    CHECK(json.find("\"Item (placeholder)\"") != std::string::npos);
+    CHECK(report.toString().contains("No leaked placeholders"));
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_compactPlaceholders()
+{
+    // Tests that placeholders of closed dock widgets are removed by count and by age,
+    // explicitly and through Config::setPlaceholderCompactionInterval()
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    Core::Layout *layout = m->layout();
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }), {}, {}, /*show=*/false);
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }), {}, {}, /*show=*/false);
+    auto dock3 = createDockWidget("3", Platform::instance()->tests_createView({ true }), {}, {}, /*show=*/false);
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom, dock2);
+
+    dock2->close();
+    dock3->close();
+    EVENT_LOOP(100); // Groups are deleted later, they hold a ref too
+    CHECK_EQ(layout->placeholderCount(), 2);
+    CHECK(dock2->hasPreviousDockedLocation());
+
+    // Nothing to do without limits
+    CHECK(DockRegistry::self()->compactPlaceholders().isEmpty());
+
+    // dock2 was closed first, so it goes first
+    PlaceholderCompactionResult result = DockRegistry::self()->compactPlaceholders(-1, 1);
+    CHECK_EQ(result.removedPlaceholders, 1);
+    CHECK_EQ(result.removedReferences, 1);
+    CHECK_EQ(result.removedContainers, 1); // dock3 was alone in a nested container
+    CHECK_EQ(layout->placeholderCount(), 1);
+    CHECK(!dock2->hasPreviousDockedLocation());
+    CHECK(dock3->hasPreviousDockedLocation());
+    CHECK(layout->checkSanity());
+
+    // Visible items are never touched
+    result = layout->compactPlaceholders(0, 0);
+    CHECK_EQ(result.removedPlaceholders, 1);
+    CHECK_EQ(layout->placeholderCount(), 0);
+    CHECK_EQ(layout->visibleCount(), 1);
+    CHECK(layout->checkSanity());
+
+    // The idle policy
+    Config::self().setMaxPlaceholdersPerLayout(0);
+    Config::self().setPlaceholderCompactionInterval(0);
+    m->addDockWidget(dock3, Location_OnRight);
+    dock3->close();
+    EVENT_LOOP(200);
+    Config::self().setMaxPlaceholdersPerLayout(-1);
+    Config::self().setPlaceholderCompactionInterval(-1);
+    CHECK_EQ(layout->placeholderCount(), 0);
+    CHECK(!dock3->hasPreviousDockedLocation());
+    CHECK(layout->checkSanity());
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_layoutFileCache()
+{
+    // Tests that restoreFromFile() reuses the parsed layout, but not once the file changes
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }));
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    const QString withDock2 = QStringLiteral("layout_tst_layoutFileCache1.json");
+    const QString withoutDock2 = QStringLiteral("layout_tst_layoutFileCache2.json");
+    auto &cache = LayoutSaver::Private::s_fileCache;
+
+    LayoutSaver saver;
+    CHECK(saver.saveToFile(withDock2));
+    dock2->close();
+    CHECK(saver.saveToFile(withoutDock2));
+
+    // Disabled by default
+    {
+        SetExpectedWarning ignoreWarning("The cache is disabled");
+        CHECK(!LayoutSaver::preloadFile(withDock2));
+    }
+    CHECK(saver.restoreFromFile(withDock2));
+    CHECK(cache.entries.empty());
+    CHECK(dock2->isOpen());
+
+    Config::self().setLayoutFileCacheSize(1024 * 1024);
+    CHECK(LayoutSaver::preloadFile(withDock2));
+    CHECK(LayoutSaver::preloadFile(withoutDock2));
+    CHECK_EQ(int(cache.entries.size()), 2);
+
+    CHECK(saver.restoreFromFile(withoutDock2));
+    CHECK(!dock2->isOpen());
+    CHECK(saver.restoreFromFile(withDock2));
+    CHECK(dock2->isOpen());
+    CHECK_EQ(int(cache.entries.size()), 2);
+
+    // A changed file is parsed again
+    dock2->close();
+    CHECK(saver.saveToFile(withDock2));
+    CHECK(saver.restoreFromFile(withDock2));
+    CHECK(!dock2->isOpen());
+
+    // Least recently used files are evicted once they don't fit
+    bool ok = false;
+    const int size1 = Platform::instance()->readFile(withDock2, ok).size();
+    const int size2 = Platform::instance()->readFile(withoutDock2, ok).size();
+    LayoutSaver::clearFileCache();
+    Config::self().setLayoutFileCacheSize(std::max(size1, size2));
+    CHECK(LayoutSaver::preloadFile(withDock2));
+    CHECK(LayoutSaver::preloadFile(withoutDock2));
+    CHECK_EQ(int(cache.entries.size()), 1);
+    CHECK_EQ(int(cache.entries.count(withoutDock2)), 1);
+
+    // Once a file is old enough, its modification time and size tell that it didn't change,
+    // so it's not even read
+    const std::filesystem::path path = withoutDock2.toStdString();
+    const auto oldTime = std::filesystem::last_write_time(path) - std::chrono::hours(1);
+    std::filesystem::last_write_time(path, oldTime);
+    CHECK(LayoutSaver::preloadFile(withoutDock2));
+
+    // Same size and modification time, but it's not a layout anymore
+    const auto fileSize = std::filesystem::file_size(path);
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << std::string(fileSize, ' ');
+    }
+    std::filesystem::last_write_time(path, oldTime);
+    CHECK(saver.restoreFromFile(withoutDock2));
+
+    LayoutSaver::clearFileCache();
+    CHECK(cache.entries.empty());
+
+    KDDW_TEST_RETURN(true);
+}
+
+static int s_numGuestViewsCreated = 0;
+
+static Core::DockWidget *createLazyDockWidget(const QString &name)
+{
+    auto dw = Config::self().viewFactory()->createDockWidget(name)->asDockWidgetController();
+    dw->setGuestViewProvider([](Core::DockWidget *dock) {
+        ++s_numGuestViewsCreated;
+        dock->setGuestView(Platform::instance()->tests_createView({ true })->asWrapper());
+    });
+
+    return dw;
+}
+
+KDDW_QCORO_TASK tst_guestViewProvider()
+{
+    // Tests that deferred guests are only created once the dock widget is actually visible
+
+    EnsureTopLevelsDeleted e;
+    s_numGuestViewsCreated = 0;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "mainWindow1");
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    auto dock2 = createLazyDockWidget("2");
+    auto dock3 = createLazyDockWidget("3");
+    CHECK(dock2->hasPendingGuestView());
+    CHECK(!dock2->guestView());
+
+    // Adding it as the current tab needs the guest
+    dock1->addDockWidgetAsTab(dock2);
+    CHECK_EQ(s_numGuestViewsCreated, 1);
+    CHECK(!dock2->hasPendingGuestView());
+    CHECK(dock2->guestView());
+
+    // Closed and never shown, so still pending
+    CHECK(!dock3->isOpen());
+    CHECK(dock3->hasPendingGuestView());
+
+    dock1->addDockWidgetAsTab(dock3);
+    CHECK_EQ(s_numGuestViewsCreated, 2);
+    dock2->setAsCurrentTab();
+
+    LayoutSaver saver;
+    const QByteArray saved = saver.serializeLayout();
+    delete dock2;
+    delete dock3;
+    EVENT_LOOP(100);
+
+    // Restoring recreates both, but only the current tab gets its guest
+    KDDockWidgets::Config::self().setDockWidgetFactoryFunc(createLazyDockWidget);
+    CHECK(saver.restoreLayout(saved));
+    dock2 = DockRegistry::self()->dockByName("2");
+    dock3 = DockRegistry::self()->dockByName("3");
+    CHECK(dock2);
+    CHECK(dock3);
+    CHECK(dock2->isCurrentTab());
+    CHECK(dock3->isOpen());
+    CHECK_EQ(s_numGuestViewsCreated, 3);
+    CHECK(dock2->guestView());
+    CHECK(dock3->hasPendingGuestView());
+
+    dock3->setAsCurrentTab();
+    CHECK_EQ(s_numGuestViewsCreated, 4);
+    CHECK(dock3->guestView());
+
+    KDDW_TEST_RETURN(true);
+}
+
 KDDW_QCORO_TASK tst_doesntHaveNativeTitleBar()
 {
     // Tests that a floating window doesn't have a native title bar
@@ -326,6 +765,15 @@ KDDW_QCORO_TASK tst_LayoutSaverOpenedDocks()
     CHECK(LayoutSaver::openedDockWidgetsInLayout(saved1).isEmpty());
     CHECK(LayoutSaver::openedDockWidgetsInLayout(saved2) == Vector<QString>({ "1", "2" }));
 
+    LayoutSaver::LayoutInfo info;
+    CHECK(LayoutSaver::inspectLayout(saved2, info));
+    CHECK_EQ(info.serializationVersion, KDDOCKWIDGETS_SERIALIZATION_VERSION);
+    CHECK_EQ(info.mainWindowNames.size(), 1);
+    CHECK(info.dockWidgetNames == Vector<QString>({ "1", "2", "3" }));
+    CHECK(info.closedDockWidgetNames == Vector<QString>({ "3" }));
+    CHECK(info.sideBarDockWidgetNames.isEmpty());
+    CHECK(!LayoutSaver::inspectLayout(QByteArray::fromStdString("{ \"mainWindows\": ["), info));
+
     KDDW_TEST_RETURN(true);
 }
 
@@ -4357,6 +4805,49 @@ KDDW_QCORO_TASK tst_titleBarFocusedWhenTabsChange()
     KDDW_TEST_RETURN(true);
 }
 
+KDDW_QCORO_TASK tst_focusScopesFollowFocus()
+{
+    // Tests that only the group containing the focused view is focused, including after
+    // the previously focused group is deleted
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None, "MainWindow1");
+    auto dock1 = createDockWidget("dock1", Platform::instance()->tests_createFocusableView({ true }));
+    auto dock2 = createDockWidget("dock2", Platform::instance()->tests_createFocusableView({ true }));
+    auto dock3 = createDockWidget("dock3", Platform::instance()->tests_createFocusableView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom);
+
+    Core::Group *group1 = dock1->dptr()->group();
+    Core::Group *group2 = dock2->dptr()->group();
+    Core::Group *group3 = dock3->dptr()->group();
+
+    dock1->guestView()->setFocus(Qt::MouseFocusReason);
+    CHECK(dock1->isFocused() || (WAIT_FOR_EVENT(dock1->guestView().get(), Event::FocusIn)));
+    CHECK(group1->isFocused());
+    CHECK(!group2->isFocused());
+    CHECK(!group3->isFocused());
+
+    dock2->guestView()->setFocus(Qt::MouseFocusReason);
+    CHECK(dock2->isFocused() || (WAIT_FOR_EVENT(dock2->guestView().get(), Event::FocusIn)));
+    CHECK(!dock1->isFocused());
+    CHECK(!group1->isFocused());
+    CHECK(group2->isFocused());
+
+    // The focused group goes away
+    ObjectGuard<Core::Group> guard2 = group2;
+    dock2->close();
+    WAIT_FOR_DELETED(guard2);
+
+    dock3->guestView()->setFocus(Qt::MouseFocusReason);
+    CHECK(dock3->isFocused() || (WAIT_FOR_EVENT(dock3->guestView().get(), Event::FocusIn)));
+    CHECK(group3->isFocused());
+    CHECK(!group1->isFocused());
+
+    KDDW_TEST_RETURN(true);
+}
+
 KDDW_QCORO_TASK tst_floatingAction()
 {
     // Tests DockWidget::floatAction()
@@ -5714,6 +6205,120 @@ KDDW_QCORO_TASK tst_mdiZorder()
     KDDW_TEST_RETURN(true);
 }
 
+KDDW_QCORO_TASK tst_mdiGroupAt()
+{
+    // Tests MDILayout's hit testing and stacking queries
+    EnsureTopLevelsDeleted e;
+
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_MDI);
+    auto layout = m->layout()->asMDILayout();
+
+    auto dock0 = createDockWidget(
+        "dock0", Platform::instance()->tests_createView({ true, {}, Size(200, 200) }));
+    auto dock1 = createDockWidget(
+        "dock1", Platform::instance()->tests_createView({ true, {}, Size(200, 200) }));
+
+    layout->addDockWidget(dock0, Point(0, 0), {});
+    layout->addDockWidget(dock1, Point(100, 100), {});
+    dock0->setMDISize({ 200, 200 });
+    dock1->setMDISize({ 200, 200 });
+
+    Core::Group *group0 = dock0->dptr()->group();
+    Core::Group *group1 = dock1->dptr()->group();
+
+    CHECK_EQ(layout->groupAt(Point(50, 50)), group0);
+    CHECK_EQ(layout->groupAt(Point(150, 150)), group1);
+    CHECK_EQ(layout->groupAt(Point(290, 290)), group1);
+    CHECK(!layout->groupAt(Point(500, 400)));
+    CHECK(layout->groupsInStackingOrder() == Vector<Core::Group *>({ group0, group1 }));
+    CHECK(layout->groupsIntersecting(Rect(140, 140, 10, 10))
+          == Vector<Core::Group *>({ group1, group0 }));
+    CHECK(layout->groupsIntersecting(Rect(250, 250, 10, 10)) == Vector<Core::Group *>({ group1 }));
+
+    // Raising dock0 puts it above dock1 where they overlap
+    dock0->raise();
+    CHECK_EQ(layout->groupAt(Point(150, 150)), group0);
+    CHECK(layout->groupsInStackingOrder() == Vector<Core::Group *>({ group1, group0 }));
+
+    // Geometry changes are picked up
+    layout->moveDockWidget(group1, Point(400, 250));
+    CHECK_EQ(layout->groupAt(Point(500, 300)), group1);
+    CHECK(!layout->groupAt(Point(250, 250)));
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_mdiResizeInterval()
+{
+    // Tests Config::setWindowResizeInterval() and Config::setLazyWindowResize() with MDI
+
+    if (!Platform::instance()->isQtWidgets()) {
+        // QtQuick drives MDI resizing from QML
+        KDDW_TEST_RETURN(true);
+    }
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_MDI);
+    auto layout = m->layout()->asMDILayout();
+
+    auto dock0 = createDockWidget(
+        "dock0", Platform::instance()->tests_createView({ true, {}, Size(200, 200) }));
+    layout->addDockWidget(dock0, Point(10, 10), {});
+    dock0->setMDISize({ 200, 200 });
+
+    Core::Group *group = dock0->dptr()->group();
+    View *view = group->view();
+    EventFilterInterface *handler = group->resizeHandler();
+    CHECK(handler);
+
+    auto sendMouseEvent = [handler, view](Event::Type type, Point localPos, Qt::MouseButtons buttons) {
+        MouseEvent ev(type, localPos, localPos, view->mapToGlobal(localPos), Qt::LeftButton, buttons,
+                      Qt::NoModifier);
+        handler->onMouseEvent(view, &ev);
+    };
+
+    // Presses the bottom-right corner and moves it by @p delta
+    auto pressAndMove = [&sendMouseEvent, view](Point delta) {
+        const Point corner(view->width() - 1, view->height() - 1);
+        sendMouseEvent(Event::MouseButtonPress, corner, Qt::LeftButton);
+        sendMouseEvent(Event::MouseMove, corner + delta, Qt::LeftButton);
+        return corner + delta;
+    };
+
+    // Coalesced: Applied a frame later, or on release
+    Config::self().setWindowResizeInterval(0);
+    Size expected = view->size() + Size(30, 20);
+    Point pos = pressAndMove(Point(30, 20));
+    CHECK_EQ(view->size(), expected - Size(30, 20));
+    EVENT_LOOP(200);
+    CHECK_EQ(view->size(), expected);
+
+    sendMouseEvent(Event::MouseMove, pos + Point(10, 10), Qt::LeftButton);
+    sendMouseEvent(Event::MouseButtonRelease, pos + Point(10, 10), Qt::NoButton);
+    expected = expected + Size(10, 10);
+    CHECK_EQ(view->size(), expected);
+
+    // Lazy: Only applied on release
+    Config::self().setWindowResizeInterval(-1);
+    Config::self().setLazyWindowResize(true);
+    pos = pressAndMove(Point(-40, -30));
+    EVENT_LOOP(200);
+    CHECK_EQ(view->size(), expected);
+    sendMouseEvent(Event::MouseButtonRelease, pos, Qt::NoButton);
+    expected = expected - Size(40, 30);
+    CHECK_EQ(view->size(), expected);
+
+    // Lazy, but someone ate the release. Applied with the next move without buttons.
+    pos = pressAndMove(Point(20, 20));
+    CHECK_EQ(view->size(), expected);
+    sendMouseEvent(Event::MouseMove, pos, Qt::NoButton);
+    expected = expected + Size(20, 20);
+    CHECK_EQ(view->size(), expected);
+    CHECK(!DockRegistry::self()->groupInMDIResize());
+
+    KDDW_TEST_RETURN(true);
+}
+
 KDDW_QCORO_TASK tst_mdiZorder2()
 {
     // Tests that clicking a mdi widget will NOT raise its when using MDIFlag_NoClickToRaise
@@ -5815,6 +6420,57 @@ KDDW_QCORO_TASK tst_redockToMDIRestoresPosition()
     KDDW_TEST_RETURN(true);
 }
 
+KDDW_QCORO_TASK tst_itemForGroup()
+{
+    // Tests that the guest index behind itemForGroup() follows groups around
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(Size(800, 500), MainWindowOption_None);
+    Core::DropArea *layout = m->multiSplitter();
+
+    auto dock1 = createDockWidget("1", Platform::instance()->tests_createView({ true }));
+    auto dock2 = createDockWidget("2", Platform::instance()->tests_createView({ true }));
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    Core::Group *group1 = dock1->dptr()->group();
+    Item *item1 = layout->itemForGroup(group1);
+    CHECK(item1);
+    CHECK_EQ(item1->guest(), group1->asLayoutingGuest());
+    CHECK(layout->containsGroup(group1));
+
+    // Placeholders aren't found
+    dock1->setFloating(true);
+    CHECK(!layout->containsGroup(dock1->dptr()->group()));
+    CHECK_EQ(layout->placeholderCount(), 1);
+
+    // A whole floating layout is nested into the main window's layout
+    auto fw = dock1->floatingWindow();
+    fw->addDockWidget(dock2, Location_OnRight, nullptr);
+    Core::Group *group2 = dock2->dptr()->group();
+    CHECK(fw->dropArea()->containsGroup(group2));
+
+    layout->addMultiSplitter(fw->dropArea(), Location_OnRight);
+    CHECK(layout->containsGroup(dock1->dptr()->group()));
+    CHECK(layout->containsGroup(dock2->dptr()->group()));
+    CHECK_EQ(layout->itemForGroup(dock2->dptr()->group())->guest(),
+             dock2->dptr()->group()->asLayoutingGuest());
+    CHECK(WAIT_FOR_DELETED(fw));
+
+    // MDI
+    auto mdi = createMainWindow(Size(800, 500), MainWindowOption_MDI, "mdi");
+    auto dock3 = createDockWidget("3", Platform::instance()->tests_createView({ true }));
+    auto mdiLayout = mdi->layout()->asMDILayout();
+    mdiLayout->addDockWidget(dock3, Point(10, 10), {});
+    Core::Group *group3 = dock3->dptr()->group();
+    CHECK(mdiLayout->containsGroup(group3));
+    CHECK(!layout->containsGroup(group3));
+
+    mdiLayout->moveDockWidget(group3, Point(50, 50));
+    CHECK_EQ(mdiLayout->itemForGroup(group3)->pos(), Point(50, 50));
+
+    KDDW_TEST_RETURN(true);
+}
+
 KDDW_QCORO_TASK tst_restoreWithNativeTitleBar()
 {
 #ifdef Q_OS_WIN // Other OS don't support this
@@ -6513,6 +7169,15 @@ static const auto s_tests = std::vector<KDDWTest> {
     TEST(tst_preferredInitialSizeVsMinSize),
     TEST(tst_fairResizeAfterRemoveWidget),
     TEST(tst_minMaxGuest),
+    TEST(tst_dockByName),
+    TEST(tst_restoreBinary),
+    TEST(tst_serializeLayoutIncremental),
+    TEST(tst_groupContainingPos),
+    TEST(tst_profiler),
+    TEST(tst_memoryReport),
+    TEST(tst_compactPlaceholders),
+    TEST(tst_layoutFileCache),
+    TEST(tst_guestViewProvider),
     TEST(tst_doesntHaveNativeTitleBar),
     TEST(tst_sizeAfterRedock),
     TEST(tst_honourUserGeometry),
@@ -6548,15 +7213,19 @@ static const auto s_tests = std::vector<KDDWTest> {
     TEST(tst_addToSmallMainWindow2),
     TEST(tst_addToSmallMainWindow3),
     TEST(tst_titleBarFocusedWhenTabsChange),
+    TEST(tst_focusScopesFollowFocus),
     TEST(tst_toggleTabbed),
     TEST(tst_currentTabMatchesDockWidget),
     TEST(tst_addMDIDockWidget),
     TEST(tst_mdiZorder),
     TEST(tst_mdiCrash),
     TEST(tst_mdiZorder2),
+    TEST(tst_mdiGroupAt),
+    TEST(tst_mdiResizeInterval),
     TEST(tst_mdiSetSize),
     TEST(tst_mixedMDIRestoreToArea),
     TEST(tst_redockToMDIRestoresPosition),
+    TEST(tst_itemForGroup),
     TEST(tst_maximizeButton),
     TEST(tst_restoreAfterUnminimized),
     TEST(tst_doubleScheduleDelete),
@@ -23,6 +23,7 @@
 
 #include <memory.h>
 #include <cstdlib>
+#include <functional>
 #include <utility>
 
 using namespace KDDockWidgets;
@@ -76,6 +77,8 @@ public:
         if (r != geometry()) {
             m_numSetGeometry++;
             m_view->setGeometry(r);
+            if (m_onSetGeometry)
+                m_onSetGeometry();
         }
     }
 
@@ -97,6 +100,7 @@ public:
     LayoutingHost *m_host = nullptr;
     View *const m_view;
     int m_numSetGeometry = 0;
+    std::function<void()> m_onSetGeometry;
 };
 
 }
@@ -1217,6 +1221,137 @@ KDDW_QCORO_TASK tst_numSeparators()
     KDDW_TEST_RETURN(true);
 }
 
+KDDW_QCORO_TASK tst_recycledSeparators()
+{
+    DeleteViews deleteViews;
+
+    auto root = createRoot();
+    LayoutingHost *host = root->host();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnLeft);
+    CHECK_EQ(root->separators_recursive().size(), 1);
+    LayoutingSeparator *separator = root->separators_recursive().constFirst();
+
+    // An unused separator goes into the host's pool
+    root->removeItem(item2);
+    CHECK_EQ(root->separators_recursive().size(), 0);
+    CHECK_EQ(host->numRecycledSeparators(), 1);
+    CHECK(!separator->parentContainer());
+
+    // A different orientation can't reuse it
+    Item *item3 = createItem();
+    root->insertItem(item3, Location_OnTop);
+    CHECK_EQ(host->numRecycledSeparators(), 1);
+    root->removeItem(item3);
+    CHECK_EQ(host->numRecycledSeparators(), 2);
+
+    // Same orientation reuses it
+    Item *item4 = createItem();
+    root->insertItem(item4, Location_OnRight);
+    CHECK_EQ(root->separators_recursive().size(), 1);
+    CHECK_EQ(root->separators_recursive().constFirst(), separator);
+    CHECK_EQ(separator->parentContainer(), root.get());
+    CHECK_EQ(host->numRecycledSeparators(), 1);
+    CHECK(root->checkSanity());
+
+    // Honours the cap
+    const int oldMax = Item::maxRecycledSeparators;
+    Item::maxRecycledSeparators = 0;
+    root->removeItem(item4);
+    CHECK_EQ(host->numRecycledSeparators(), 1);
+    Item::maxRecycledSeparators = oldMax;
+
+    host->clearRecycledSeparators();
+    CHECK_EQ(host->numRecycledSeparators(), 0);
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_itemRangeRecursive()
+{
+    DeleteViews deleteViews;
+
+    auto root = createRoot();
+    CHECK(root->itemRange_recursive().begin() == root->itemRange_recursive().end());
+
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    Item *item3 = createItem();
+    Item *item4 = createItem();
+    Item *item5 = createItem();
+
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    root->insertItem(item3, Location_OnBottom);
+    ItemBoxContainer::insertItemRelativeTo(item4, item2, Location_OnBottom);
+    ItemBoxContainer::insertItemRelativeTo(item5, item4, Location_OnRight,
+                                           KDDockWidgets::InitialVisibilityOption::StartHidden);
+
+    Item::List items;
+    for (Item *item : root->itemRange_recursive())
+        items.push_back(item);
+    CHECK(items == root->items_recursive());
+    CHECK_EQ(items.size(), 5);
+
+    Item::List visibleItems;
+    for (Item *item : root->visibleItemRange_recursive())
+        visibleItems.push_back(item);
+    CHECK_EQ(visibleItems.size(), 4);
+    CHECK(!visibleItems.contains(item5));
+
+    // Stopping early
+    int count = 0;
+    CHECK(!root->visit_recursive([&count](Item *) { return ++count < 2; }));
+    CHECK_EQ(count, 2);
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_cachedSizeConstraints()
+{
+    // Containers cache their min and max sizes, test that nested changes invalidate them
+
+    DeleteViews deleteViews;
+
+    auto root = createRoot();
+    Item *item1 = createItem(Size(100, 100));
+    Item *item2 = createItem(Size(100, 100));
+    Item *item3 = createItem(Size(100, 100));
+
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    ItemBoxContainer::insertItemRelativeTo(item3, item2, Location_OnBottom);
+
+    auto container = item3->parentBoxContainer();
+    CHECK(container != root.get());
+    const int spacing = Item::layoutSpacing;
+    CHECK_EQ(root->minSize(), Size(200 + spacing, 200 + spacing));
+
+    // Nested min-size change reaches the root
+    item3->setMinSize(Size(300, 400));
+    CHECK_EQ(container->minSize(), Size(300, 500 + spacing));
+    CHECK_EQ(root->minSize(), Size(400 + spacing, 500 + spacing));
+
+    // Hiding an item
+    item3->turnIntoPlaceholder();
+    CHECK_EQ(root->minSize(), Size(200 + spacing, 100));
+
+    // Max size
+    item1->setMaxSizeHint(Size(300, 300));
+    item2->setMaxSizeHint(Size(300, 300));
+    CHECK_EQ(root->maxSizeHint(), Size(600 + spacing, 300));
+    item2->setMaxSizeHint(Size(400, 400));
+    CHECK_EQ(root->maxSizeHint(), Size(700 + spacing, 300));
+
+    // Removing an item
+    root->removeItem(item1);
+    CHECK_EQ(root->maxSizeHint().width(), 400);
+
+    KDDW_TEST_RETURN(true);
+}
+
 KDDW_QCORO_TASK tst_separatorMinMax()
 {
     DeleteViews deleteViews;
@@ -2313,6 +2448,83 @@ KDDW_QCORO_TASK tst_relayoutIfNeeded()
     KDDW_TEST_RETURN(true);
 }
 
+KDDW_QCORO_TASK tst_atomicGeometryCommit()
+{
+    // Guests only get their final geometry, once, when the outermost AtomicGeometryCommit ends
+    DeleteViews deleteViews;
+
+    auto root = createRoot();
+    auto item1 = createItem();
+    auto item2 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    CHECK(root->checkSanity());
+
+    auto guest2 = static_cast<Guest *>(item2->guest());
+    const Rect oldGuestGeometry = guest2->geometry();
+    guest2->m_numSetGeometry = 0;
+
+    {
+        AtomicGeometryCommit commit;
+        root->setSize_recursive({ 1200, 1000 });
+        root->setSize_recursive({ 1100, 1000 });
+        CHECK_EQ(guest2->m_numSetGeometry, 0);
+        CHECK_EQ(guest2->geometry(), oldGuestGeometry);
+        CHECK(root->checkSanity());
+
+        // The separator's length changes too, sanity checks must look at its pending geometry
+        root->setSize_recursive({ 1100, 900 });
+        CHECK(root->checkSanity());
+    }
+
+    CHECK_EQ(guest2->m_numSetGeometry, 1);
+    CHECK_EQ(guest2->geometry(), item2->mapToRoot(item2->rect()));
+    CHECK(root->checkSanity());
+
+    KDDW_TEST_RETURN(true);
+}
+
+KDDW_QCORO_TASK tst_atomicGeometryCommitReentrancy()
+{
+    // A guest reacting to its new geometry can remove an item which was already committed,
+    // from within an AtomicGeometryCommit of its own
+    DeleteViews deleteViews;
+
+    auto root = createRoot();
+    auto item1 = createItem();
+    auto item2 = createItem();
+    auto item3 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    root->insertItem(item3, Location_OnRight);
+    CHECK(root->checkSanity());
+
+    auto guest3 = static_cast<Guest *>(item3->guest());
+    bool removed = false;
+    guest3->m_onSetGeometry = [&removed, &root, item1] {
+        if (!removed) {
+            removed = true;
+            AtomicGeometryCommit commit;
+            root->removeItem(item1);
+        }
+    };
+
+    {
+        AtomicGeometryCommit commit;
+        root->setSize_recursive({ 1200, 1000 });
+    }
+
+    guest3->m_onSetGeometry = nullptr;
+    CHECK(removed);
+    CHECK_EQ(root->numChildren(), 2);
+    CHECK(root->checkSanity());
+
+    CHECK_EQ(item2->guest()->geometry(), item2->mapToRoot(item2->rect()));
+    CHECK_EQ(guest3->geometry(), item3->mapToRoot(item3->rect()));
+
+    KDDW_TEST_RETURN(true);
+}
+
 static const std::vector<KDDWTest> s_tests = {
     TEST(tst_createRoot),
     TEST(tst_insertOne),
@@ -2344,6 +2556,9 @@ static const std::vector<KDDWTest> s_tests = {
     TEST(tst_containerGetsHidden),
     TEST(tst_minSizeChanges),
     TEST(tst_numSeparators),
+    TEST(tst_recycledSeparators),
+    TEST(tst_itemRangeRecursive),
+    TEST(tst_cachedSizeConstraints),
     TEST(tst_separatorMinMax),
     TEST(tst_separatorRecreatedOnParentChange),
     TEST(tst_containerReducesSize),
@@ -2373,6 +2588,8 @@ static const std::vector<KDDWTest> s_tests = {
     TEST(tst_outermostNeighbor),
     TEST(tst_relativeToHidden),
     TEST(tst_spuriousResize),
+    TEST(tst_atomicGeometryCommit),
+    TEST(tst_atomicGeometryCommitReentrancy),
 };
 
 #include "tests_main.h"
@@ -15,6 +15,7 @@
 // clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
 
 #include "Config.h"
+#include "LayoutSaver.h"
 #include "core/Logging_p.h"
 #include "kddockwidgets/KDDockWidgets.h"
 #include "core/DockRegistry.h"
@@ -112,6 +113,14 @@ struct EnsureTopLevelsDeleted
         Config::self().setMDIFlags(m_originalMDIFlags);
         Config::self().setSeparatorThickness(m_originalSeparatorThickness);
         Config::self().setLayoutSaverStrictMode(false);
+        Config::self().setSeparatorMoveInterval(-1);
+        Config::self().setWindowResizeInterval(-1);
+        Config::self().setLazyWindowResize(false);
+        Config::self().setPlaceholderMaxAge(-1);
+        Config::self().setMaxPlaceholdersPerLayout(-1);
+        Config::self().setPlaceholderCompactionInterval(-1);
+        Config::self().setLayoutFileCacheSize(0);
+        LayoutSaver::clearFileCache();
         InitialOption::s_defaultNeighbourSqueezeStrategy = NeighbourSqueezeStrategy::AllNeighbours;
     }
 